@@ -275,6 +275,7 @@ public class Build {
                 buf.append("-DSQUAWK_64=false ").append("-m32 ");
             }
             buf.append("-DIOPORT ");
+            buf.append("-DZYGOTE ");
             return buf.append(options.cflags).append(' ').toString();
         }
 
@@ -348,6 +349,7 @@ public class Build {
             if (options.typemap)            { buf.append("-DTYPEMAP ");         }
             if (options.maxinline)          { buf.append("-DMAXINLINE -O3 ");   }
             buf.append("-DIOPORT ");
+            buf.append("-DZYGOTE ");
             return buf.append(options.cflags).append(' ').toString();
         }
 
@@ -417,6 +419,7 @@ public class Build {
             if (options.maxinline)          { buf.append("-DMAXINLINE -xO5 ");  }
             if (options.is64)               { buf.append("-DSQUAWK_64=true ").append("-xarch=v9 "); }
             buf.append("-DIOPORT ");
+            buf.append("-DZYGOTE ");
             return buf.append(options.cflags).append(' ').toString();
         }
 
@@ -879,7 +882,7 @@ public class Build {
             public int run(String cmd, String[] args) throws Exception {
                 stdout.println("Running romizer...");
                 String options = join(args, 0, args.length, " ");
-                return java("-Xmx300M -Xbootclasspath#a:j2se/classes;romizer/classes;j2me/classes;translator/classes", "java.lang.Romizer", options);
+                return romize(options);
             }
         },
         new Command("rom") { // Clever romize option
@@ -967,20 +970,13 @@ public class Build {
                 // Only run the romizer if there is one or more directory of classes passed to the 'rom' command
                 if (args.length > 0) {
                     String options = "-arch:" + ccompiler.getSquawkCompilerName(Build.this.cOptions) + " " + extractRomizerOptions(args);
-                    int res = java("-Xmx300M -Xbootclasspath#a:j2se/classes;romizer/classes;j2me/classes;translator/classes", "java.lang.Romizer", options);
+                    int res = romize(options);
                     if (res != 0) {
                         return res;
                     }
 
                     // Modify the prefix of the compiler output files if necessary
-                    int index = options.indexOf("-o:");
-                    if (index != -1) {
-                        int end = options.indexOf(' ', index);
-                        if (end == -1) {
-                            end = options.length();
-                        }
-                        outPrefix = options.substring(index + "-o:".length(), end);
-                    }
+                    outPrefix = getRomizerPrefix(options);
                 }
 
                 // Run the C compiler to compile the slow VM
@@ -1202,6 +1198,188 @@ public class Build {
     boolean clearJppLines = false;
     boolean wobulateClasses = false;
     String  buildPropsFile = "build.properties";
+    String  romCacheDir = null;
+
+
+    /*---------------------------------------------------------------------------*\
+     *                            Romizer output cache                           *
+    \*---------------------------------------------------------------------------*/
+
+    /**
+     * The class path of the JVM running the romizer.
+     */
+    private final static String ROMIZER_CLASSPATH = "j2se/classes;romizer/classes;j2me/classes;translator/classes";
+
+    /**
+     * Runs the romizer. If a cache directory was specified with '-romcache' and the romizer
+     * has already been run with the same options over the same inputs, then the files it
+     * generated are copied from the cache instead.
+     * <p>
+     * The inputs are the romizer options, the build properties, the classes of the romizer
+     * itself (including the translator) and every file or directory named in the options.
+     * The class numbers, object layouts and object tables of a suite are computed over all
+     * of its classes and so a suite is only ever reused as a whole.
+     *
+     * @param  options  the romizer options
+     * @return the exit code of the romizer
+     */
+    int romize(String options) throws Exception {
+        String prefix = getRomizerPrefix(options);
+        String[] outputs = { prefix + ".suite", prefix + ".sym", "slowvm/src/vm/rom.h" };
+        File entry = null;
+        if (romCacheDir != null) {
+            entry = new File(fix(romCacheDir), digestRomizerInputs(options, prefix));
+            if (entry.isDirectory()) {
+                stdout.println("Reusing romizer output from " + entry.getPath());
+                for (int i = 0; i != outputs.length; ++i) {
+                    File output = new File(fix(outputs[i]));
+                    output.delete();
+                    copyFile(new File(entry, output.getName()), output);
+                }
+                return 0;
+            }
+        }
+
+        int res = java("-Xmx300M -Xbootclasspath#a:" + ROMIZER_CLASSPATH, "java.lang.Romizer", options);
+
+        if (res == 0 && entry != null) {
+            File temp = new File(entry.getPath() + ".tmp");
+            ensureDirExists(temp.getPath());
+            for (int i = 0; i != outputs.length; ++i) {
+                File output = new File(fix(outputs[i]));
+                if (!output.exists()) {
+                    return res; // nothing was romized (e.g. '-help')
+                }
+                copyFile(output, new File(temp, output.getName()));
+            }
+            if (!temp.renameTo(entry)) {
+                stderr.println("Warning: could not add romizer output to cache " + entry.getPath());
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Gets the prefix of the files generated by the romizer.
+     *
+     * @param  options  the romizer options
+     * @return the value of the '-o:' option or "squawk" if it is not given
+     */
+    static String getRomizerPrefix(String options) {
+        int index = options.indexOf("-o:");
+        if (index == -1) {
+            return "squawk";
+        }
+        int end = options.indexOf(' ', index);
+        if (end == -1) {
+            end = options.length();
+        }
+        return options.substring(index + "-o:".length(), end);
+    }
+
+    /**
+     * Computes the digest that identifies a romizer run.
+     *
+     * @param  options  the romizer options
+     * @param  prefix   the prefix of the files generated by the romizer
+     * @return the digest as a hexadecimal string
+     */
+    private String digestRomizerInputs(String options, String prefix) throws Exception {
+        java.security.MessageDigest md = java.security.MessageDigest.getInstance("MD5");
+        md.update(options.getBytes());
+        digestFile(md, new File(buildPropsFile));
+        digestFile(md, new File("build.override"));
+        digestFile(md, new File(prefix + ".exclude"));
+
+        StringTokenizer st = new StringTokenizer(ROMIZER_CLASSPATH, ";");
+        while (st.hasMoreTokens()) {
+            digestFile(md, new File(fix(st.nextToken())));
+        }
+
+        /*
+         * Add every file or directory named in the options (e.g. class path entries,
+         * class directories and the files given to '-exclude:' or '-shake:')
+         */
+        st = new StringTokenizer(options, " ");
+        while (st.hasMoreTokens()) {
+            String arg = st.nextToken();
+            if (arg.startsWith("-")) {
+                int index = arg.indexOf(':');
+                if (index == -1) {
+                    continue;
+                }
+                arg = arg.substring(index + 1);
+            }
+            StringTokenizer paths = new StringTokenizer(arg, File.pathSeparator);
+            while (paths.hasMoreTokens()) {
+                digestFile(md, new File(paths.nextToken()));
+            }
+        }
+
+        byte[] digest = md.digest();
+        StringBuffer buf = new StringBuffer(digest.length * 2);
+        for (int i = 0; i != digest.length; ++i) {
+            String hex = Integer.toHexString(digest[i] & 0xFF);
+            if (hex.length() == 1) {
+                buf.append('0');
+            }
+            buf.append(hex);
+        }
+        return buf.toString();
+    }
+
+    /**
+     * Adds the path and contents of a file, or of all the files under a directory, to a digest.
+     * Nothing is added for a file that does not exist.
+     *
+     * @param  md    the digest
+     * @param  file  the file or directory
+     */
+    private static void digestFile(java.security.MessageDigest md, File file) throws IOException {
+        if (file.isDirectory()) {
+            String[] names = file.list();
+            Arrays.sort(names);
+            for (int i = 0; i != names.length; ++i) {
+                digestFile(md, new File(file, names[i]));
+            }
+        } else if (file.exists()) {
+            md.update(file.getPath().getBytes());
+            InputStream is = new FileInputStream(file);
+            try {
+                byte[] buf = new byte[8192];
+                int n;
+                while ((n = is.read(buf)) != -1) {
+                    md.update(buf, 0, n);
+                }
+            } finally {
+                is.close();
+            }
+        }
+    }
+
+    /**
+     * Copies a file.
+     *
+     * @param  from  the file to copy
+     * @param  to    the copy
+     */
+    private static void copyFile(File from, File to) throws IOException {
+        InputStream is = new FileInputStream(from);
+        try {
+            OutputStream os = new FileOutputStream(to);
+            try {
+                byte[] buf = new byte[8192];
+                int n;
+                while ((n = is.read(buf)) != -1) {
+                    os.write(buf, 0, n);
+                }
+            } finally {
+                os.close();
+            }
+        } finally {
+            is.close();
+        }
+    }
 
 
     /*---------------------------------------------------------------------------*\
@@ -1631,6 +1809,8 @@ public class Build {
         usageln(true,  out, "    -props <file>       add to/override default properties from <file>");
         usageln(true,  out, "    -Dname=[value]      sets build property 'name' to 'value' (default='true')");
         usageln(true,  out, "    -wobulate           wobulate j2me and translator classes (default='false')");
+        usageln(false, out, "    -romcache:<dir>     reuse the files generated by a previous run of the");
+        usageln(false, out, "                        romizer with the same options and inputs from <dir>");
         usageln(false, out, "    -help               show this usage message and exit");
         usageln(false, out, "");
         usageln(true,  out, "The '-tracing' and '-assume' options are");
@@ -1828,6 +2008,8 @@ public class Build {
                 props.put("J2ME.DEBUG", "true");
             } else if (arg.equals("-wobulate")) {
                 wobulateClasses = true;
+            } else if (arg.startsWith("-romcache:")) {
+                romCacheDir = arg.substring("-romcache:".length());
             } else if (arg.equals("-help")) {
                 usage(null, true);
             } else {
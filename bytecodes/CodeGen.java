@@ -329,6 +329,8 @@ public class CodeGen {
         make("lookup_b",            PARM_N, -1,   FLOW_CALL);
         make("lookup_s",            PARM_N, -1,   FLOW_CALL);
 
+        make("aload_unchecked_i",   PARM_N, -1,   FLOW_NEXT);
+
         if (next > 256) {
             System.err.println("Too many bytecodes "+next);
             System.exit(1);
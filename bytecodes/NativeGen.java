@@ -97,6 +97,7 @@ public class NativeGen {
         lookup(Class.forName("java.lang.ServiceOperation"), false);
         lookup(Class.forName("java.lang.Lisp2Bitmap"), false);
         lookup(Class.forName("java.lang.Lisp2Bitmap$Iterator"), false);
+        lookup(Class.forName("com.sun.squawk.util.Arrays"), false);
 
         output(Class.forName("java.lang.VM"), "lcmp", true, new Class[] { Long.TYPE, Long.TYPE }, Integer.TYPE);
         int nextB4Floats = next;
@@ -140,8 +140,7 @@ public final class ChannelConstants {
         INTERNAL_PRINTOFFSET            = 1006,
         INTERNAL_PRINTLONG              = 1007,
         INTERNAL_PRINTADDRESS           = 1008,
-        INTERNAL_GETTIME_LOW            = 1009,
-        INTERNAL_GETTIME_HIGH           = 1010,
+        INTERNAL_GETTIME                = 1009,     /* 64 bit result: low word in 'result', high word in 'resultHigh' */
         INTERNAL_STOPVM                 = 1011,
         INTERNAL_COPYBYTES              = 1012,
         INTERNAL_PRINTCONFIGURATION     = 1013,
@@ -150,6 +149,9 @@ public final class ChannelConstants {
         INTERNAL_MATH                   = 1016,
         INTERNAL_GETPATHSEPARATORCHAR   = 1017,
         INTERNAL_GETFILESEPARATORCHAR   = 1018,
+        INTERNAL_PRINTBYTES             = 1019,
+        INTERNAL_FLUSHSTREAM            = 1020,
+        INTERNAL_ZYGOTE                 = 1021,     /* only returns in a forked child: result is the argc of the launch request or -1 if not a zygote */
 
         DUMMY = 999;
 
@@ -78,17 +78,17 @@ public class FieldOffsets {
     /**
      * The offset of the 'classID' field in java.lang.Klass.
      */
-    public final static long java_lang_Klass$classID = (/*VAL*/false/*SQUAWK_64*/ ? 22 : 11) + INT;
+    public final static long java_lang_Klass$classID = (/*VAL*/false/*SQUAWK_64*/ ? 24 : 12) + INT;
 
     /**
      * The offset of the 'modifiers' field in java.lang.Klass.
      */
-    public final static long java_lang_Klass$modifiers = (/*VAL*/false/*SQUAWK_64*/ ? 23 : 12) + INT;
+    public final static long java_lang_Klass$modifiers = (/*VAL*/false/*SQUAWK_64*/ ? 25 : 13) + INT;
 
     /**
      * The offset of the 'instanceSize' field in java.lang.Klass.
      */
-    public final static long java_lang_Klass$instanceSize = (/*VAL*/false/*SQUAWK_64*/ ? 50 : 28) + SHORT;
+    public final static long java_lang_Klass$instanceSize = (/*VAL*/false/*SQUAWK_64*/ ? 54 : 30) + SHORT;
 
     /**
      * The offset of the 'entryTable' field in com.sun.squawk.util.Hashtable.
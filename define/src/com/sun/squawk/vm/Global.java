@@ -58,6 +58,7 @@ public final class Global {
           java_lang_VM$currentIsolate                   = Oop("java.lang.VM.currentIsolate")
         , java_lang_VM$extendsEnabled                   = Int("java.lang.VM.extendsEnabled")
         , java_lang_VM$usingTypeMap                     = Int("java.lang.VM.usingTypeMap")
+        , java_lang_VM$exceptionsEnabled                = Int("java.lang.VM.exceptionsEnabled")
 
         , java_lang_GC$traceFlags                       = Int("java.lang.GC.traceFlags")
         , java_lang_GC$collecting                       = Int("java.lang.GC.collecting")
@@ -83,6 +84,7 @@ public final class Global {
         , java_lang_ServiceOperation$o1                 = Add("java.lang.ServiceOperation.o1")
         , java_lang_ServiceOperation$o2                 = Add("java.lang.ServiceOperation.o2")
         , java_lang_ServiceOperation$result             = Int("java.lang.ServiceOperation.result")
+        , java_lang_ServiceOperation$resultHigh         = Int("java.lang.ServiceOperation.resultHigh")
 
         , branchCountHigh                               = Int("branchCountHigh")
         , branchCountLow                                = Int("branchCountLow")
@@ -99,6 +101,8 @@ public final class Global {
 //        , writeBarrierBase                              = Add("writeBarrierBase")       // The logical base of the write barrier if it contained a bit for address 0.
         , newCount                                      = Int("newCount")
         , newHits                                       = Int("newHits")
+        , throwCount                                    = Int("throwCount")
+        , throwHits                                     = Int("throwHits")
         ;
 
     /**
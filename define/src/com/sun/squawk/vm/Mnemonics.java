@@ -275,7 +275,7 @@ public final class Mnemonics {
         "lookup_i",
         "lookup_b",
         "lookup_s",
-        "res_0",
+        "aload_unchecked_i",
 /*if[FLOATS]*/
         "if_eq_f",
         "if_ne_f",
@@ -146,17 +146,21 @@ public final class Native {
     public final static int java_lang_Lisp2Bitmap$setBitFor               = 124;
     public final static int java_lang_Lisp2Bitmap$testAndSetBitFor        = 125;
     public final static int java_lang_Lisp2Bitmap$testBitFor              = 126;
-    public final static int java_lang_VM$lcmp                             = 127;
+    public final static int com_sun_squawk_util_Arrays$binarySearchPrimitive = 127;
+    public final static int com_sun_squawk_util_Arrays$equalsPrimitive    = 128;
+    public final static int com_sun_squawk_util_Arrays$fillPrimitive      = 129;
+    public final static int com_sun_squawk_util_Arrays$sortPrimitive      = 130;
+    public final static int java_lang_VM$lcmp                             = 131;
 /*if[FLOATS]*/
-    public final static int java_lang_VM$fcmpl                            = 128;
-    public final static int java_lang_VM$fcmpg                            = 129;
-    public final static int java_lang_VM$dcmpl                            = 130;
-    public final static int java_lang_VM$dcmpg                            = 131;
-    public final static int java_lang_VM$math                             = 132;
-    public final static int java_lang_VM$floatToIntBits                   = 133;
-    public final static int java_lang_VM$doubleToLongBits                 = 134;
-    public final static int java_lang_VM$intBitsToFloat                   = 135;
-    public final static int java_lang_VM$longBitsToDouble                 = 136;
+    public final static int java_lang_VM$fcmpl                            = 132;
+    public final static int java_lang_VM$fcmpg                            = 133;
+    public final static int java_lang_VM$dcmpl                            = 134;
+    public final static int java_lang_VM$dcmpg                            = 135;
+    public final static int java_lang_VM$math                             = 136;
+    public final static int java_lang_VM$floatToIntBits                   = 137;
+    public final static int java_lang_VM$doubleToLongBits                 = 138;
+    public final static int java_lang_VM$intBitsToFloat                   = 139;
+    public final static int java_lang_VM$longBitsToDouble                 = 140;
 /*end[FLOATS]*/
-    public final static int ENTRY_COUNT                                   = /*VAL*/false/*FLOATS*/ ? 137 : 128;
+    public final static int ENTRY_COUNT                                   = /*VAL*/false/*FLOATS*/ ? 141 : 132;
 }
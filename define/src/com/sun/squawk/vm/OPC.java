@@ -275,7 +275,7 @@ public final class OPC {
         LOOKUP_I               = 252,
         LOOKUP_B               = 253,
         LOOKUP_S               = 254,
-        RES_0                  = 255,
+        ALOAD_UNCHECKED_I      = 255,
 /*if[FLOATS]*/
         IF_EQ_F                = 256,
         IF_NE_F                = 257,
@@ -513,7 +513,8 @@ public static final int OBJECT_0_COUNT=16;
 public static final int LOAD_0_COUNT=16;
 public static final int STORE_0_COUNT=16;
 public static final int LOADPARM_0_COUNT=8;
-public static final int RES_0_COUNT=1;
+public static final int RES_0=-1;
+public static final int RES_0_COUNT=0;
 
 public static final int BYTECODE_COUNT               = /*VAL*/false/*FLOATS*/ ? 336 : 256;
 public static final int FIRST_PARM_BYTECODE          = 91;
@@ -527,6 +528,6 @@ public static final int WIDE_DELTA                   = FIRST_WIDE_PSEUDOCODE
 public static final int ESCAPE_WIDE_DELTA            = FIRST_ESCAPE_WIDE_PSEUDOCODE - FIRST_ESCAPE_PARM_BYTECODE;
 
 public static final String LENGTH_TABLE = "\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0002\u0003\u0003\u0005\u0009\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0002\u0001\u0001\u0001\u0001\u0005\u0009\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001";
-public static final String STACK_EFFECT_TABLE = "\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0000\u0000\u0000\u0000\u0000\u0000\u0000\u0000\u0000\u0000\u0000\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0002\u0001\u0001\u0002\u00ff\u00fe\u0001\u0002\u00ff\u00fe\u0000\u0000\u0000\u0000\u0000\u00ff\u00ff\u00fe\u00fe\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fc\u00fc\u00fc\u00fc\u00fc\u00fc\u0000\u0000\u0001\u0001\u0001\u0002\u00fe\u00fe\u00fd\u00ff\u00ff\u00fe\u0000\u0000\u0000\u0000\u0000\u0001\u0001\u0001\u0001\u0001\u0001\u0002\u00fe\u00fe\u00fe\u00fe\u00fd\u00ff\u00ff\u00ff\u00ff\u00fe\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u00fe\u0000\u009c\u009c\u009c\u009c\u0000\u00ff\u00fe\u00ff\u00ff\u00ff\u0000\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u0000\u0000\u0000\u0000\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u0000\u00ff\u00ff\u00ff\u00ff\u0001\u00ff\u00ff\u00fe\u00ff\u00ff\u0000\u0000\u0000\u00ff\u00ff\u00ff\u0000\u0000\u0000\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u0000\u00fd\u00fd\u00fd\u00fd\u00fc\u00ff\u00ff\u00ff\u0000\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fc\u00fc\u00fc\u00fc\u00fc\u00fc\u0000\u0001\u0001\u0002\u00fe\u00fd\u00ff\u00fe\u0000\u0001\u0001\u0002\u00fe\u00fd\u00ff\u00fe\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u00ff\u00fe\u0001\u0002\u00ff\u00ff\u00ff\u00ff\u00ff\u0000\u00fe\u00fe\u00fe\u00fe\u00fe\u0000\u0000\u00ff\u0000\u0001\u0001\u0000\u0001\u00ff\u0000\u00ff\u00ff\u0000\u00fd\u00fc";
+public static final String STACK_EFFECT_TABLE = "\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0000\u0000\u0000\u0000\u0000\u0000\u0000\u0000\u0000\u0000\u0000\u0001\u0001\u0001\u0001\u0001\u0001\u0001\u0002\u0001\u0001\u0002\u00ff\u00fe\u0001\u0002\u00ff\u00fe\u0000\u0000\u0000\u0000\u0000\u00ff\u00ff\u00fe\u00fe\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fc\u00fc\u00fc\u00fc\u00fc\u00fc\u0000\u0000\u0001\u0001\u0001\u0002\u00fe\u00fe\u00fd\u00ff\u00ff\u00fe\u0000\u0000\u0000\u0000\u0000\u0001\u0001\u0001\u0001\u0001\u0001\u0002\u00fe\u00fe\u00fe\u00fe\u00fd\u00ff\u00ff\u00ff\u00ff\u00fe\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u00fe\u0000\u009c\u009c\u009c\u009c\u0000\u00ff\u00fe\u00ff\u00ff\u00ff\u0000\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u0000\u0000\u0000\u0000\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u0000\u00ff\u00ff\u00ff\u00ff\u0001\u00ff\u00ff\u00fe\u00ff\u00ff\u0000\u0000\u0000\u00ff\u00ff\u00ff\u0000\u0000\u0000\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u0000\u00fd\u00fd\u00fd\u00fd\u00fc\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00ff\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fe\u00fc\u00fc\u00fc\u00fc\u00fc\u00fc\u0000\u0001\u0001\u0002\u00fe\u00fd\u00ff\u00fe\u0000\u0001\u0001\u0002\u00fe\u00fd\u00ff\u00fe\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u009c\u00ff\u00fe\u0001\u0002\u00ff\u00ff\u00ff\u00ff\u00ff\u0000\u00fe\u00fe\u00fe\u00fe\u00fe\u0000\u0000\u00ff\u0000\u0001\u0001\u0000\u0001\u00ff\u0000\u00ff\u00ff\u0000\u00fd\u00fc";
 
 }
@@ -13,48 +13,140 @@ import java.io.*;
 
 /**
  * ChannelInputStream
+ * <p>
+ * Unless the buffer size of the parent connection is zero, the data is
+ * read ahead into a buffer that is refilled with a single READBUF operation
+ * so that reading a primitive value does not cost one channel operation
+ * per value. The mark and reset operations are not supported on a
+ * buffered stream.
  */
 public class ChannelInputStream extends DataInputStream {
 
     Protocol parent;
     int channelID;
 
+    /**
+     * The read-ahead buffer or null if this stream is not buffered.
+     */
+    private byte[] buf;
+
+    /**
+     * The index of the next byte to be read from <code>buf</code>.
+     */
+    private int pos;
+
+    /**
+     * The index one greater than the last valid byte in <code>buf</code>.
+     */
+    private int count;
+
     public ChannelInputStream(Protocol parent) throws IOException {
         super(null);
         this.parent = parent;
         this.channelID = parent.channelID;
+        if (parent.bufferSize > 0) {
+            buf = new byte[parent.bufferSize];
+        }
         VM.execIO(ChannelConstants.OPENINPUT, channelID, 0, 0, 0, 0, 0, 0, null, null);
     }
 
+    /**
+     * Refills the read-ahead buffer. This must only be called when the buffer is empty.
+     *
+     * @return the number of bytes read into the buffer or -1 if the end of the stream was reached
+     */
+    private int fill() throws IOException {
+        pos = 0;
+        count = 0;
+        int n = VM.execIO(ChannelConstants.READBUF, channelID, 0, buf.length, 0, 0, 0, 0, null, buf);
+        if (n > 0) {
+            count = n;
+        }
+        return n;
+    }
+
     public void close() throws IOException {
         if (channelID != -1) {
             VM.execIO(ChannelConstants.CLOSEINPUT, channelID, 0, 0, 0, 0, 0, 0, null, null);
             channelID = -1;
+            buf = null;
             parent.decrementCount();
         }
     }
 
     public int read() throws IOException {
-        return VM.execIO(ChannelConstants.READBYTE, channelID, 0, 0, 0, 0, 0, 0, null, null);
+        if (buf == null) {
+            return VM.execIO(ChannelConstants.READBYTE, channelID, 0, 0, 0, 0, 0, 0, null, null);
+        }
+        if (pos >= count && fill() <= 0) {
+            return -1;
+        }
+        return buf[pos++] & 0xFF;
     }
 
     public int readUnsignedShort() throws IOException {
-        return VM.execIO(ChannelConstants.READSHORT, channelID, 0, 0, 0, 0, 0, 0, null, null);
+        if (buf == null) {
+            return VM.execIO(ChannelConstants.READSHORT, channelID, 0, 0, 0, 0, 0, 0, null, null);
+        }
+        if (count - pos < 2) {
+            return super.readUnsignedShort();
+        }
+        int value = ((buf[pos] & 0xFF) << 8) + (buf[pos + 1] & 0xFF);
+        pos += 2;
+        return value;
     }
 
     public int readInt() throws IOException {
-        return VM.execIO(ChannelConstants.READINT, channelID, 0, 0, 0, 0, 0, 0, null, null);
+        if (buf == null) {
+            return VM.execIO(ChannelConstants.READINT, channelID, 0, 0, 0, 0, 0, 0, null, null);
+        }
+        if (count - pos < 4) {
+            return super.readInt();
+        }
+        int value = ((buf[pos]     & 0xFF) << 24) +
+                    ((buf[pos + 1] & 0xFF) << 16) +
+                    ((buf[pos + 2] & 0xFF) << 8)  +
+                     (buf[pos + 3] & 0xFF);
+        pos += 4;
+        return value;
     }
 
     public long readLong() throws IOException {
-        return VM.execIOLong(ChannelConstants.READLONG, channelID, 0, 0, 0, 0, 0, 0, null, null);
+        if (buf == null) {
+            return VM.execIOLong(ChannelConstants.READLONG, channelID, 0, 0, 0, 0, 0, 0, null, null);
+        }
+        return ((long)readInt() << 32) + (readInt() & 0xFFFFFFFFL);
     }
 
     public int read(byte b[], int off, int len) throws IOException {
         if (b == null) {
             throw new NullPointerException();
         }
-        return VM.execIO(ChannelConstants.READBUF, channelID, off, len, 0, 0, 0, 0, null, b);
+        if (buf == null) {
+            return VM.execIO(ChannelConstants.READBUF, channelID, off, len, 0, 0, 0, 0, null, b);
+        }
+        if ((off | len | (off + len) | (b.length - (off + len))) < 0) {
+            throw new IndexOutOfBoundsException();
+        } else if (len == 0) {
+            return 0;
+        }
+        int avail = count - pos;
+        if (avail <= 0) {
+            /*
+             * Read requests at least as large as the buffer bypass it.
+             */
+            if (len >= buf.length) {
+                return VM.execIO(ChannelConstants.READBUF, channelID, off, len, 0, 0, 0, 0, null, b);
+            }
+            avail = fill();
+            if (avail <= 0) {
+                return -1;
+            }
+        }
+        int n = (avail < len) ? avail : len;
+        System.arraycopy(buf, pos, b, off, n);
+        pos += n;
+        return n;
     }
 
     public int read(byte b[]) throws IOException {
@@ -62,27 +154,48 @@ public class ChannelInputStream extends DataInputStream {
     }
 
     public long skip(long n) throws IOException {
-        return VM.execIO(ChannelConstants.SKIP, channelID, (int)(n >>> 32), (int)n, 0, 0, 0, 0, null, null);
+        if (n <= 0) {
+            return 0;
+        }
+        long skipped = 0;
+        if (buf != null) {
+            int avail = count - pos;
+            skipped = (avail < n) ? avail : n;
+            pos += (int)skipped;
+            n -= skipped;
+            if (n == 0) {
+                return skipped;
+            }
+        }
+        return skipped + VM.execIO(ChannelConstants.SKIP, channelID, (int)(n >>> 32), (int)n, 0, 0, 0, 0, null, null);
     }
 
     public int available() throws IOException {
-        return VM.execIO(ChannelConstants.AVAILABLE, channelID, 0, 0, 0, 0, 0, 0, null, null);
+        int buffered = (buf == null) ? 0 : count - pos;
+        return buffered + VM.execIO(ChannelConstants.AVAILABLE, channelID, 0, 0, 0, 0, 0, 0, null, null);
     }
 
     public void mark(int readlimit) {
-        try {
-            VM.execIO(ChannelConstants.MARK, channelID, readlimit, 0, 0, 0, 0, 0, null, null);
-        } catch (IOException ex) {}
-
+        if (buf == null) {
+            try {
+                VM.execIO(ChannelConstants.MARK, channelID, readlimit, 0, 0, 0, 0, 0, null, null);
+            } catch (IOException ex) {}
+        }
     }
 
     public void reset() throws IOException {
+        if (buf != null) {
+            throw new IOException("mark/reset not supported");
+        }
         VM.execIO(ChannelConstants.RESET, channelID, 0, 0, 0, 0, 0, 0, null, null);
     }
 
     public boolean markSupported() {
+        if (buf != null) {
+            return false;
+        }
         try {
-            int res = VM.execIO(ChannelConstants.MARK, channelID, 0, 0, 0, 0, 0, 0, null, null);
+            int res = VM.execIO(ChannelConstants.MARKSUPPORTED, channelID, 0, 0, 0, 0, 0, 0, null, null);
             return res != 0;
         } catch (IOException ex) {
             return false;
@@ -90,5 +203,3 @@ public class ChannelInputStream extends DataInputStream {
     }
 
 }
-
-
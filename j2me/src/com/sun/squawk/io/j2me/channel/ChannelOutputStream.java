@@ -13,35 +13,91 @@ import com.sun.squawk.vm.ChannelConstants;
 
 /**
  * ChannelOutputStream
+ * <p>
+ * Unless the buffer size of the parent connection is zero, the data written
+ * is collected in a buffer that is sent with a single WRITEBUF operation when
+ * it fills up or the stream is flushed or closed.
  */
 public class ChannelOutputStream extends DataOutputStream {
 
     Protocol parent;
     int channelID;
 
+    /**
+     * The write-behind buffer or null if this stream is not buffered.
+     */
+    private byte[] buf;
+
+    /**
+     * The number of valid bytes in <code>buf</code>.
+     */
+    private int count;
+
     public ChannelOutputStream(Protocol parent) throws IOException {
         super(null);
         this.parent = parent;
         this.channelID = parent.channelID;
+        if (parent.bufferSize > 0) {
+            buf = new byte[parent.bufferSize];
+        }
         VM.execIO(ChannelConstants.OPENOUTPUT, channelID, 0, 0, 0, 0, 0, 0, null, null);
     }
 
+    /**
+     * Sends the contents of the write-behind buffer (if any) to the channel.
+     */
+    private void flushBuffer() throws IOException {
+        if (count > 0) {
+            VM.execIO(ChannelConstants.WRITEBUF, channelID, 0, count, 0, 0, 0, 0, buf, null);
+            count = 0;
+        }
+    }
+
+    /**
+     * Ensures that there is room for a given number of bytes in the write-behind buffer.
+     *
+     * @param n  the number of bytes about to be written
+     */
+    private void ensureRoom(int n) throws IOException {
+        if (count + n > buf.length) {
+            flushBuffer();
+        }
+    }
+
     public void flush() throws IOException {
+        if (buf != null) {
+            flushBuffer();
+        }
         VM.execIO(ChannelConstants.FLUSH, channelID, 0, 0, 0, 0, 0, 0, null, null);
     }
 
     public void close() throws IOException {
+        if (buf != null) {
+            flushBuffer();
+            buf = null;
+        }
         VM.execIO(ChannelConstants.CLOSEOUTPUT, channelID, 0, 0, 0, 0, 0, 0, null, null);
         channelID = -1;
         parent.decrementCount();
     }
 
     public void write(int v) throws IOException {
-        VM.execIO(ChannelConstants.WRITEBYTE, channelID, v, 0, 0, 0, 0, 0, null, null);
+        if (buf == null) {
+            VM.execIO(ChannelConstants.WRITEBYTE, channelID, v, 0, 0, 0, 0, 0, null, null);
+        } else {
+            ensureRoom(1);
+            buf[count++] = (byte)v;
+        }
     }
 
     public void writeShort(int v) throws IOException {
-        VM.execIO(ChannelConstants.WRITESHORT, channelID, v, 0, 0, 0, 0, 0, null, null);
+        if (buf == null) {
+            VM.execIO(ChannelConstants.WRITESHORT, channelID, v, 0, 0, 0, 0, 0, null, null);
+        } else {
+            ensureRoom(2);
+            buf[count++] = (byte)(v >>> 8);
+            buf[count++] = (byte)v;
+        }
     }
 
     public void writeChar(int v) throws IOException {
@@ -49,20 +105,43 @@ public class ChannelOutputStream extends DataOutputStream {
     }
 
     public void writeInt(int v) throws IOException {
-        VM.execIO(ChannelConstants.WRITEINT, channelID, v, 0, 0, 0, 0, 0, null, null);
+        if (buf == null) {
+            VM.execIO(ChannelConstants.WRITEINT, channelID, v, 0, 0, 0, 0, 0, null, null);
+        } else {
+            ensureRoom(4);
+            buf[count++] = (byte)(v >>> 24);
+            buf[count++] = (byte)(v >>> 16);
+            buf[count++] = (byte)(v >>> 8);
+            buf[count++] = (byte)v;
+        }
     }
 
     public void writeLong(long v) throws IOException {
-        VM.execIO(ChannelConstants.WRITELONG, channelID, (int)(v >>> 32), (int)v, 0, 0, 0, 0, null, null);
+        if (buf == null) {
+            VM.execIO(ChannelConstants.WRITELONG, channelID, (int)(v >>> 32), (int)v, 0, 0, 0, 0, null, null);
+        } else {
+            writeInt((int)(v >>> 32));
+            writeInt((int)v);
+        }
     }
 
     public void write(byte b[], int off, int len) throws IOException {
         if (b == null) {
             throw new NullPointerException();
         }
+        if (buf != null) {
+            if (len < buf.length) {
+                ensureRoom(len);
+                System.arraycopy(b, off, buf, count, len);
+                count += len;
+                return;
+            }
+            /*
+             * Write requests at least as large as the buffer bypass it.
+             */
+            flushBuffer();
+        }
         VM.execIO(ChannelConstants.WRITEBUF, channelID, off, len, 0, 0, 0, 0, b, null);
     }
 
 }
-
-
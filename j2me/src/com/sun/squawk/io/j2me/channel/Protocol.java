@@ -43,6 +43,23 @@ public class Protocol extends ConnectionBase implements StreamConnection, Stream
      */
     int useCount = 0;
 
+    /**
+     * The default size of the read-ahead and write-behind buffers.
+     */
+    private final static int DEFAULT_BUFFER_SIZE = 2048;
+
+    /**
+     * The smallest non-zero buffer size. This allows any primitive value to fit in a buffer.
+     */
+    private final static int MIN_BUFFER_SIZE = 8;
+
+    /**
+     * The size of the read-ahead and write-behind buffers used by the streams of
+     * this connection. This is taken from the "com.sun.squawk.io.j2me.channel.buffersize"
+     * system property if it is set and a value of zero disables buffering.
+     */
+    int bufferSize;
+
     /**
      * Public constructor
      */
@@ -52,11 +69,33 @@ public class Protocol extends ConnectionBase implements StreamConnection, Stream
     /**
      * Private constructor
      */
-    private Protocol(int chan) {
+    private Protocol(int chan, int bufferSize) {
         this.channelID = chan;
+        this.bufferSize = bufferSize;
         useCount++;
     }
 
+    /**
+     * Gets the configured size for stream buffers.
+     *
+     * @return the buffer size
+     */
+    private static int getConfiguredBufferSize() {
+        String value = System.getProperty("com.sun.squawk.io.j2me.channel.buffersize");
+        if (value == null) {
+            return DEFAULT_BUFFER_SIZE;
+        }
+        try {
+            int size = Integer.parseInt(value);
+            if (size <= 0) {
+                return 0;
+            }
+            return size < MIN_BUFFER_SIZE ? MIN_BUFFER_SIZE : size;
+        } catch (NumberFormatException ex) {
+            throw new IllegalArgumentException("Bad channel buffer size: " + value);
+        }
+    }
+
     /**
      * open
      */
@@ -64,6 +103,7 @@ public class Protocol extends ConnectionBase implements StreamConnection, Stream
         if (protocol == null || name == null) {
             throw new NullPointerException();
         }
+        bufferSize = getConfiguredBufferSize();
         channelID = VM.getChannel(ChannelConstants.CHANNEL_GENERIC);
         useCount++;
         VM.execIO(ChannelConstants.OPENCONNECTION, channelID, mode, timeouts?1:0, 0, 0, 0, 0, protocol+":"+name, null);
@@ -75,11 +115,7 @@ public class Protocol extends ConnectionBase implements StreamConnection, Stream
      */
     public InputStream openInputStream() throws IOException {
         useCount++;
-        InputStream is = new ChannelInputStream(this);
-/*if[BUFFERCHANNELINPUT]*/
-        is = new BufferedInputStream(is);
-/*end[BUFFERCHANNELINPUT]*/
-        return is;
+        return new ChannelInputStream(this);
     }
 
     /**
@@ -95,7 +131,7 @@ public class Protocol extends ConnectionBase implements StreamConnection, Stream
      */
     public StreamConnection acceptAndOpen() throws IOException {
         int newChan = VM.execIO(ChannelConstants.ACCEPTCONNECTION, channelID, 0, 0, 0, 0, 0, 0, null, null);
-        return new Protocol(newChan);
+        return new Protocol(newChan, bufferSize);
     }
 
     /**
@@ -56,6 +56,30 @@ public class Protocol extends ConnectionBase implements ClasspathConnection {
      */
     private Vector classPathArray = new Vector();
 
+    /**
+     * The index of each classpath entry, built the first time the entry is
+     * searched. The index of a zip or jar entry is a table of all the file
+     * names in its central directory. The index of a directory entry is a
+     * table mapping each directory searched so far (relative to the entry)
+     * to the table of the plain file names it contains.
+     */
+    private Hashtable[] indexes;
+
+    /**
+     * The modification time of each zip or jar entry when its index was built.
+     */
+    private long[] indexTimes;
+
+    /**
+     * The names of the files that have been looked for and not found on any entry.
+     */
+    private Hashtable missing = new Hashtable();
+
+    /**
+     * Placeholder value used for the entries of an index.
+     */
+    private static final Object PRESENT = "";
+
     /**
      * Open the connection
      */
@@ -77,6 +101,8 @@ public class Protocol extends ConnectionBase implements ClasspathConnection {
             }
             classPathArray.addElement(dirName);
         }
+        indexes = new Hashtable[classPathArray.size()];
+        indexTimes = new long[classPathArray.size()];
 
         return this;
     }
@@ -95,6 +121,40 @@ public class Protocol extends ConnectionBase implements ClasspathConnection {
             return lookupRequest(fileName);
         }
 
+       /*
+        * A file that is not found according to the indexes may have been added to
+        * a zip or jar file since it was indexed. The indexes of the zip and jar
+        * entries are only checked for this when a lookup fails so that finding a
+        * file costs no more than before.
+        */
+        boolean checked = false;
+        if (missing.get(fileName) != null) {
+            if (!invalidateStaleIndexes()) {
+                throw new ConnectionNotFoundException(fileName);
+            }
+            checked = true;
+        }
+
+        InputStream is = findInputStream(fileName);
+        if (is == null && !checked && invalidateStaleIndexes()) {
+            is = findInputStream(fileName);
+        }
+
+        if (is == null) {
+            missing.put(fileName, PRESENT);
+            throw new ConnectionNotFoundException(fileName);
+        }
+
+        return is;
+    }
+
+    /**
+     * Opens a file on the first classpath entry that contains it.
+     *
+     * @param fileName  the name of the file relative to the classpath entries
+     * @return an input stream for the file or null if it was not found
+     */
+    private InputStream findInputStream(String fileName) throws IOException {
         InputStream is = null;
         for (int i = 0  ; i < classPathArray.size(); i++) {
 
@@ -103,6 +163,13 @@ public class Protocol extends ConnectionBase implements ClasspathConnection {
             */
             String classPathEntry = (String)classPathArray.elementAt(i);
 
+           /*
+            * Skip the entry without probing it if its index shows that it does not contain the file
+            */
+            if (!isIndexed(i, fileName)) {
+                continue;
+            }
+
 //System.out.println("classPathEntry = "+classPathEntry);
 
             if (classPathEntry.endsWith(".zip") || classPathEntry.endsWith(".jar")) {
@@ -151,11 +218,110 @@ public class Protocol extends ConnectionBase implements ClasspathConnection {
             }
         }
 
-        if (is == null) {
-            throw new ConnectionNotFoundException(fileName);
+        return is;
+    }
+
+    /**
+     * Discards the index of each zip or jar entry whose file has been modified
+     * since the index was built, together with the record of missing files.
+     *
+     * @return true if any index was discarded
+     */
+    private boolean invalidateStaleIndexes() {
+        boolean stale = false;
+        for (int i = 0; i < classPathArray.size(); i++) {
+            String classPathEntry = (String)classPathArray.elementAt(i);
+            if (indexes[i] != null && (classPathEntry.endsWith(".zip") || classPathEntry.endsWith(".jar")) &&
+                getLastModified(classPathEntry) != indexTimes[i]) {
+                indexes[i] = null;
+                stale = true;
+            }
+        }
+        if (stale) {
+            missing = new Hashtable();
         }
+        return stale;
+    }
 
-        return is;
+    /**
+     * Gets the modification time of a zip or jar file.
+     *
+     * @param zipName  the name of the file
+     * @return the modification time of the file or 0 if it cannot be determined
+     */
+    private static long getLastModified(String zipName) {
+        try {
+            DataInputStream is = Connector.openDataInputStream("zip://" + zipName + "@");
+            try {
+                return is.readLong();
+            } finally {
+                is.close();
+            }
+        } catch (IOException ex) {
+            return 0;
+        }
+    }
+
+    /**
+     * Determines if a classpath entry may contain a given file according to the
+     * index of the entry. The index is built (or extended) as necessary.
+     *
+     * @param i         the index of the classpath entry
+     * @param fileName  the name of the file relative to the entry
+     * @return false if the entry definitely does not contain the file
+     */
+    private boolean isIndexed(int i, String fileName) {
+        String classPathEntry = (String)classPathArray.elementAt(i);
+        Hashtable index = indexes[i];
+        if (index == null) {
+            index = new Hashtable();
+            if (classPathEntry.endsWith(".zip") || classPathEntry.endsWith(".jar")) {
+                indexTimes[i] = getLastModified(classPathEntry);
+                readListing(index, "zip://" + classPathEntry + "@//");
+            }
+            indexes[i] = index;
+        }
+
+        if (classPathEntry.endsWith(".zip") || classPathEntry.endsWith(".jar")) {
+            return index.get(fileName) != null;
+        }
+
+        int slash = fileName.lastIndexOf('/');
+        String dirName = fileName.substring(0, slash + 1);
+        Hashtable files = (Hashtable)index.get(dirName);
+        if (files == null) {
+            files = new Hashtable();
+            readListing(files, "file://" + classPathEntry + "/" + dirName);
+            index.put(dirName, files);
+        }
+        return files.get(fileName.substring(slash + 1)) != null;
+    }
+
+    /**
+     * Adds the names in a directory listing to a table. The names of the files
+     * in a file system directory listing are reduced to their last component.
+     * Nothing is added if the listing cannot be opened.
+     *
+     * @param table  the table to update
+     * @param url    the URL of the listing
+     */
+    private static void readListing(Hashtable table, String url) {
+        boolean zip = url.startsWith("zip:");
+        try {
+            DataInputStream is = Connector.openDataInputStream(url);
+            try {
+                for (;;) {
+                    String str = is.readUTF();
+                    if (!zip) {
+                        str = str.substring(str.lastIndexOf('/') + 1);
+                    }
+                    table.put(str, PRESENT);
+                }
+            } catch (EOFException ex) {
+            }
+            is.close();
+        } catch (IOException ex) {
+        }
     }
 
 
@@ -113,6 +113,42 @@ class PrivateOutputStream extends OutputStream {
         VM.setStream(old);
     }
 
+    /**
+     * Writes <code>len</code> bytes from the specified byte array
+     * starting at offset <code>off</code> to this output stream.
+     *
+     * @param      b     the data.
+     * @param      off   the start offset in the data.
+     * @param      len   the number of bytes to write.
+     * @exception  IOException  if an I/O error occurs. In particular,
+     *             an <code>IOException</code> is thrown if the output
+     *             stream is closed.
+     */
+    synchronized public void write(byte b[], int off, int len) throws IOException {
+        if (parent == null) {
+            throw new IOException("Connection closed");
+        }
+        if ((off | len | (off + len) | (b.length - (off + len))) < 0) {
+            throw new IndexOutOfBoundsException();
+        }
+        int old = VM.setStream(parent.err ? VM.STREAM_STDERR : VM.STREAM_STDOUT);
+        VM.print(b, off, len);
+        VM.setStream(old);
+    }
+
+    /**
+     * Flushes this output stream and forces any buffered output bytes
+     * to be written out.
+     *
+     * @exception  IOException  if an I/O error occurs.
+     */
+    synchronized public void flush() throws IOException {
+        if (parent == null) {
+            throw new IOException("Connection closed");
+        }
+        VM.flush(parent.err ? VM.STREAM_STDERR : VM.STREAM_STDOUT);
+    }
+
     /**
      * Close the stream
      *
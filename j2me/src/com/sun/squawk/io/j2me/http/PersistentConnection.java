@@ -0,0 +1,364 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM.
+ */
+
+package com.sun.squawk.io.j2me.http;
+
+import java.io.IOException;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+
+import java.util.Hashtable;
+import java.util.Vector;
+
+import javax.microedition.io.StreamConnection;
+import javax.microedition.io.Connector;
+
+/**
+ * A socket connection to an HTTP server that can carry a sequence of
+ * request/response exchanges. Connections are pooled per isolate and keyed
+ * by "host:port". A connection whose server has agreed to keep it alive is
+ * returned to the idle pool once all its responses have been read. If the
+ * server also speaks HTTP/1.1, idempotent requests may be pipelined on it:
+ * they are sent while earlier responses are still being read and are
+ * answered in the order in which they were sent.
+ * <p>
+ * The pool is configured with the following system properties:
+ * <ul>
+ * <li>"com.sun.squawk.io.j2me.http.keepalive" - set to "false" to disable connection reuse</li>
+ * <li>"com.sun.squawk.io.j2me.http.pipelining" - set to "false" to disable request pipelining</li>
+ * </ul>
+ * <p>
+ * All the state of the pool and of its connections is guarded by a single
+ * lock. This lock may be acquired while holding the lock on the response body
+ * stream of an exchange but never the other way around.
+ */
+final class PersistentConnection {
+
+    /**
+     * The maximum number of idle connections kept for any single host:port.
+     */
+    private final static int MAX_IDLE_PER_HOST = 4;
+
+    /**
+     * The maximum number of outstanding requests pipelined on a single connection.
+     */
+    private final static int MAX_PIPELINE_DEPTH = 4;
+
+    /**
+     * The lock guarding the pool and the state of its connections.
+     */
+    private static Object lock = new Object();
+
+    /**
+     * The idle connections, keyed by "host:port". Each value is a Vector of connections.
+     */
+    private static Hashtable idle = new Hashtable();
+
+    /**
+     * The connections with outstanding responses that will accept a pipelined
+     * request, keyed by "host:port". Each value is a Vector of connections.
+     */
+    private static Hashtable pipelined = new Hashtable();
+
+    /**
+     * The key of this connection in the pool.
+     */
+    private final String key;
+
+    /**
+     * The underlying socket connection and its streams.
+     */
+    private StreamConnection connection;
+    final DataInputStream input;
+    final DataOutputStream output;
+
+    /**
+     * The exchanges whose requests have been sent on this connection but whose
+     * responses have not been completely read, in the order the requests were sent.
+     */
+    private final Vector pending = new Vector();
+
+    /**
+     * Specifies if this connection has already carried at least one complete exchange.
+     * A failure to send a request on such a connection most likely means that the
+     * server closed it while it was idle.
+     */
+    private boolean reused;
+
+    /**
+     * Specifies if the server has agreed that this connection may be reused.
+     */
+    private boolean keepAlive;
+
+    /**
+     * Specifies if requests may be pipelined on this connection.
+     */
+    private boolean pipelining;
+
+    /**
+     * Specifies if this connection must not be used for any more requests.
+     */
+    private boolean broken;
+
+    /**
+     * Specifies if a request has been sent on this connection whose response headers
+     * have not yet been read. No request is pipelined behind such a request.
+     */
+    private boolean awaitingHeaders;
+
+    /**
+     * Opens a new connection.
+     *
+     * @param key   the "host:port" string identifying the server
+     */
+    private PersistentConnection(String key) throws IOException {
+        this.key = key;
+        connection = (StreamConnection)Connector.open("socket://" + key);
+        try {
+            output = connection.openDataOutputStream();
+            input = connection.openDataInputStream();
+        } catch (IOException e) {
+            connection.close();
+            throw e;
+        }
+    }
+
+    /**
+     * Gets a connection on which to send the request of an exchange and queues the
+     * exchange on the connection.
+     *
+     * @param exchange    the exchange
+     * @param host        the server host
+     * @param port        the server port
+     * @param idempotent  true if the request may be pipelined
+     * @param fresh       true if a new connection must be opened
+     * @return the connection
+     */
+    static PersistentConnection acquire(Protocol exchange, String host, int port, boolean idempotent, boolean fresh) throws IOException {
+        String key = host + ":" + port;
+        PersistentConnection conn = null;
+        synchronized (lock) {
+            if (!fresh) {
+                if (idempotent && isEnabled("pipelining")) {
+                    Vector conns = (Vector)pipelined.get(key);
+                    if (conns != null) {
+                        for (int i = 0; i != conns.size(); ++i) {
+                            PersistentConnection candidate = (PersistentConnection)conns.elementAt(i);
+                            if (!candidate.broken && !candidate.awaitingHeaders && candidate.pending.size() < MAX_PIPELINE_DEPTH) {
+                                conn = candidate;
+                                break;
+                            }
+                        }
+                    }
+                }
+                if (conn == null) {
+                    Vector conns = (Vector)idle.get(key);
+                    if (conns != null && !conns.isEmpty()) {
+                        conn = (PersistentConnection)conns.lastElement();
+                        conns.removeElementAt(conns.size() - 1);
+                    }
+                }
+            }
+            if (conn != null) {
+                conn.enqueue(exchange);
+                return conn;
+            }
+        }
+        conn = new PersistentConnection(key);
+        synchronized (lock) {
+            conn.enqueue(exchange);
+        }
+        return conn;
+    }
+
+    /**
+     * Queues an exchange whose request is about to be sent on this connection.
+     *
+     * @param exchange  the exchange
+     */
+    private void enqueue(Protocol exchange) {
+        pending.addElement(exchange);
+        awaitingHeaders = true;
+    }
+
+    /**
+     * Determines if a feature of the pool has not been disabled by a system property.
+     *
+     * @param feature  "keepalive" or "pipelining"
+     * @return false if the property for the feature is set to "false"
+     */
+    private static boolean isEnabled(String feature) {
+        return !"false".equals(System.getProperty("com.sun.squawk.io.j2me.http." + feature));
+    }
+
+    /**
+     * Determines if a failed request on this connection can safely be retried on a
+     * fresh connection. This is the case if the connection was taken from the idle
+     * pool and the request was the only one outstanding on it. It is also the case
+     * for a pipelined request that was dropped because the connection broke while
+     * responses to earlier requests were being read. A pipelined request is always
+     * idempotent.
+     *
+     * @param exchange  the exchange whose request failed
+     * @return true if the request should be retried
+     */
+    boolean isRetryable(Protocol exchange) {
+        synchronized (lock) {
+            return !pending.contains(exchange) || reused && pending.size() <= 1;
+        }
+    }
+
+    /**
+     * Waits until the response for a given exchange is the next one to be read from this
+     * connection. The remaining response bodies of any exchanges in front of it are read
+     * into memory on behalf of their owners.
+     *
+     * @param exchange  the exchange
+     */
+    void awaitResponse(Protocol exchange) throws IOException {
+        for (;;) {
+            Protocol head;
+            synchronized (lock) {
+                if (!pending.contains(exchange) || broken && pending.firstElement() != exchange) {
+                    throw new IOException("connection closed by server");
+                }
+                head = (Protocol)pending.firstElement();
+            }
+            if (head == exchange) {
+                return;
+            }
+            head.detachBody();
+        }
+    }
+
+    /**
+     * Records the connection persistence the server agreed to for the response just read.
+     *
+     * @param keepAlive   true if the server will keep the connection open after this response
+     * @param http11      true if the server speaks HTTP/1.1
+     */
+    void responseHeadersRead(boolean keepAlive, boolean http11) {
+        synchronized (lock) {
+            awaitingHeaders = false;
+            this.keepAlive = keepAlive && isEnabled("keepalive");
+            pipelining = this.keepAlive && http11;
+            if (!this.keepAlive) {
+                broken = true;
+                dropQueued();
+            }
+            if (pipelining) {
+                Vector conns = getVector(pipelined, key);
+                if (!conns.contains(this)) {
+                    conns.addElement(this);
+                }
+            }
+        }
+    }
+
+    /**
+     * Records that the response for an exchange has been completely read (or abandoned).
+     * When no more responses are outstanding the connection is either returned to the
+     * idle pool or closed.
+     *
+     * @param exchange  the exchange
+     * @param reusable  false if the connection cannot carry any more exchanges
+     */
+    void responseComplete(Protocol exchange, boolean reusable) {
+        synchronized (lock) {
+            pending.removeElement(exchange);
+            if (!reusable) {
+                broken = true;
+            }
+            if (broken) {
+                pending.removeAllElements();
+            }
+            if (pending.isEmpty()) {
+                Vector conns = (Vector)pipelined.get(key);
+                if (conns != null) {
+                    conns.removeElement(this);
+                }
+                Vector idleConns = getVector(idle, key);
+                if (broken || idleConns.size() >= MAX_IDLE_PER_HOST) {
+                    close();
+                } else {
+                    reused = true;
+                    idleConns.addElement(this);
+                }
+            }
+        }
+    }
+
+    /**
+     * Gets the vector of connections for a given key in a table, creating it if necessary.
+     *
+     * @param table  the table
+     * @param key    the "host:port" key
+     * @return the vector of connections
+     */
+    private static Vector getVector(Hashtable table, String key) {
+        Vector conns = (Vector)table.get(key);
+        if (conns == null) {
+            conns = new Vector();
+            table.put(key, conns);
+        }
+        return conns;
+    }
+
+    /**
+     * Drops the exchanges queued behind the one whose response is being read after
+     * this connection has broken. Their responses can no longer be read from it, so
+     * waiting for them fails and their requests are retried on another connection.
+     */
+    private void dropQueued() {
+        while (pending.size() > 1) {
+            pending.removeElementAt(pending.size() - 1);
+        }
+        Vector conns = (Vector)pipelined.get(key);
+        if (conns != null) {
+            conns.removeElement(this);
+        }
+    }
+
+    /**
+     * Closes this connection after a failure. Any other exchanges queued on it are
+     * dropped. Nothing is done for an exchange that has already been dropped as the
+     * connection may still be carrying the response of the exchange in front of it.
+     *
+     * @param exchange  the exchange whose request or response failed
+     */
+    void abort(Protocol exchange) {
+        synchronized (lock) {
+            if (!pending.removeElement(exchange)) {
+                return;
+            }
+            broken = true;
+            pending.removeAllElements();
+            Vector conns = (Vector)pipelined.get(key);
+            if (conns != null) {
+                conns.removeElement(this);
+            }
+            close();
+        }
+    }
+
+    /**
+     * Closes the underlying socket connection.
+     */
+    private void close() {
+        if (connection != null) {
+            try {
+                input.close();
+                output.close();
+                connection.close();
+            } catch (IOException e) {
+            }
+            connection = null;
+        }
+    }
+}
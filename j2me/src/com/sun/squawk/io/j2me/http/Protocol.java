@@ -22,12 +22,12 @@ import java.io.InputStream;
 import java.io.OutputStream;
 import java.io.DataInputStream;
 import java.io.DataOutputStream;
+import java.io.ByteArrayInputStream;
 import java.io.ByteArrayOutputStream;
 
 import java.util.Hashtable;
 import java.util.Enumeration;
 
-import javax.microedition.io.StreamConnection;
 import javax.microedition.io.Connector;
 import javax.microedition.io.Connection;
 
@@ -38,6 +38,11 @@ import com.sun.cldc.io.DateParser;
 /**
  * This class implements the necessary functionality
  * for an HTTP connection.
+ * <p>
+ * The underlying socket connections are taken from a per-isolate pool
+ * (see {@link PersistentConnection}) so that consecutive requests to the
+ * same server can reuse a kept-alive connection. Response bodies are
+ * streamed to the caller as they arrive, including chunked bodies.
  */
 public class Protocol extends ConnectionBase implements HttpConnection {
 
@@ -51,6 +56,7 @@ public class Protocol extends ConnectionBase implements HttpConnection {
     private int port = 80;
     private int responseCode;
     private String responseMsg;
+    private String responseVersion;
     private Hashtable reqProperties;
     private Hashtable headerFields;
     private String[] headerFieldNames;
@@ -68,12 +74,24 @@ public class Protocol extends ConnectionBase implements HttpConnection {
     private PrivateOutputStream out;
 
     /*
-     * The streams from the underlying socket connection.
+     * The stream from which the response body is read. This is
+     * created once the response headers have been read.
      */
-    private StreamConnection streamConnnection;
+    private PrivateInputStream body;
+
+    /*
+     * The pooled connection and its streams.
+     */
+    private PersistentConnection conn;
     private DataOutputStream streamOutput;
     private DataInputStream streamInput;
 
+    /*
+     * The maximum number of unread response body bytes that will be
+     * skipped to keep a connection alive when the exchange is closed.
+     */
+    private final static int DRAIN_LIMIT = 8192;
+
     /*
      * A shared temporary buffer used in a couple of places
      */
@@ -146,7 +164,7 @@ public class Protocol extends ConnectionBase implements HttpConnection {
 
         connect();
         opens++;
-        in = new PrivateInputStream();
+        in = body;
         return in;
     }
 
@@ -172,30 +190,122 @@ public class Protocol extends ConnectionBase implements HttpConnection {
     }
 
     /**
-     * PrivateInputStream to handle chunking for HTTP/1.1.
+     * PrivateInputStream to handle chunking for HTTP/1.1. The body is read
+     * directly from the connection unless it has been detached (see
+     * {@link #detach()}) in which case it is read from memory.
      */
     class PrivateInputStream extends InputStream {
 
-        int bytesleft;   // Number of bytes left in current chunk
-        int bytesread;   // Number of bytes read since the stream was opened
-        boolean chunked; // True if Transfer-Encoding: chunked
-        boolean eof;     // True if EOF seen
+        int bytesleft;      // Number of bytes left in current chunk or (non-chunked) body
+        int bytesread;      // Number of bytes read since the stream was opened
+        boolean chunked;    // True if Transfer-Encoding: chunked
+        boolean delimited;  // True if the end of the body is known without reading to EOF
+        boolean eof;        // True if EOF seen
+        boolean complete;   // True if the connection has been released by this exchange
+        InputStream source; // The stream from which the body is read
 
         PrivateInputStream() throws IOException {
             bytesleft = 0;
             bytesread = 0;
             chunked = false;
+            delimited = true;
             eof = false;
+            source = streamInput;
 
             // Determine if this is a chunked datatransfer and setup
             String te = (String)headerFields.get("transfer-encoding");
             if (te != null && te.equals("chunked")) {
                 chunked = true;
+            } else if (hasBody()) {
+                bytesleft = getHeaderFieldInt("content-length", -1);
+                delimited = (bytesleft >= 0);
+            }
+
+            if (chunked) {
                 bytesleft = readChunkSize();
-                eof = (bytesleft == 0);
+                if (bytesleft == 0) {
+                    readTrailers();
+                }
+            }
+        }
+
+        /**
+         * Records the persistence of the connection now that the stream has been
+         * built. Only after this can another exchange be pipelined behind this one
+         * and detach this body, so it must not be called before this stream has
+         * been assigned to {@link Protocol#body}.
+         */
+        void headersRead() {
+            conn.responseHeadersRead(delimited && isKeepAlive(), responseVersion.equals("HTTP/1.1"));
+            if (delimited && bytesleft == 0) {
+                endOfBody(true);
+            }
+        }
+
+        /**
+         * Determines if the response can have a body.
+         */
+        private boolean hasBody() {
+            return !method.equals(HEAD) &&
+                   responseCode != HTTP_NO_CONTENT &&
+                   responseCode != HTTP_NOT_MODIFIED &&
+                   (responseCode < 100 || responseCode >= 200);
+        }
+
+        /**
+         * Determines if the server will keep the connection open after this response.
+         */
+        private boolean isKeepAlive() {
+            String value = (String)headerFields.get("connection");
+            if (value != null) {
+                value = toLowerCase(value);
+            }
+            if (responseVersion.equals("HTTP/1.1")) {
+                return !"close".equals(value);
+            } else {
+                return "keep-alive".equals(value);
             }
         }
 
+        /**
+         * Records that the end of the body has been reached and releases
+         * the connection (if that has not already been done).
+         *
+         * @param reusable  false if the connection cannot carry any more exchanges
+         */
+        private void endOfBody(boolean reusable) {
+            eof = true;
+            if (!complete) {
+                complete = true;
+                conn.responseComplete(Protocol.this, reusable);
+            }
+        }
+
+        /**
+         * Ensures that there are bytes left in the current chunk of a chunked body
+         * or in a delimited body.
+         *
+         * @return false if the end of the body has been reached
+         */
+        private boolean prepare() throws IOException {
+            if (bytesleft <= 0) {
+                if (chunked) {
+                    readCRLF();    // Skip trailing \r\n
+
+                    bytesleft = readChunkSize();
+                    if (bytesleft == 0) {
+                        readTrailers();
+                        endOfBody(true);
+                        return false;
+                    }
+                } else if (delimited) {
+                    endOfBody(true);
+                    return false;
+                }
+            }
+            return true;
+        }
+
         /**
          * Returns the number of bytes that can be read (or skipped over)
          * from this input stream without blocking by the next caller of
@@ -204,10 +314,13 @@ public class Protocol extends ConnectionBase implements HttpConnection {
          * This method simply returns the number of bytes left from a
          * chunked response from an HTTP 1.1 server.
          */
-        public int available() throws IOException {
+        public synchronized int available() throws IOException {
 
             if (connected) {
-                return bytesleft ;
+                if (eof) {
+                    return 0;
+                }
+                return delimited ? bytesleft : source.available();
             } else {
                 throw new IOException("connection is not open");
             }
@@ -222,75 +335,111 @@ public class Protocol extends ConnectionBase implements HttpConnection {
          * This method blocks until input data is available, the
          * end of the stream is detected, or an exception is thrown.
          *
-         * <p> A subclass must provide an implementation of this method.
-         *
          * @return     the next byte of data, or <code>-1</code>
          *             if the end of the stream is reached.
          * @exception  IOException  if an I/O error occurs.
          */
-        public int read() throws IOException {
+        public synchronized int read() throws IOException {
 
             // Be consistent about returning EOF once encountered.
-            if (eof) {
+            if (eof || !prepare()) {
                 return -1;
             }
 
-            /* If all the current chunk has been read and this
-             * is a chunked transfer then read the next chunk length.
-             */
-            if (bytesleft <= 0 && chunked) {
-                readCRLF();    // Skip trailing \r\n
-
-                bytesleft = readChunkSize();
-                if (bytesleft == 0) {
-                    eof = true;
-                    return -1;
+            int ch = source.read();
+            if (ch == -1) {
+                if (delimited) {
+                    throw new IOException("premature end of response body");
                 }
+                endOfBody(false);
+                return -1;
             }
-
-            int ch = streamInput.read();
-            eof = (ch == -1);
             bytesleft--;
             bytesread++;
             return ch;
         }
 
         /**
-         * Reads some number of bytes from the input stream and
-         * stores them into the buffer array <code>b</code>.
-         * The number of bytes actually read is returned as an integer.
-         * This method blocks until input data is available, end of
-         * file is detected, or an exception is thrown.
-         * (For HTTP requests where the content length has been
-         * specified in the response headers, the size of the read
-         * may be reduced if there are fewer bytes left than the
-         * size of the supplied input buffer.)
+         * Reads up to <code>len</code> bytes of data from the input stream
+         * into an array of bytes. The bytes are read directly from the
+         * connection and a single call never reads past the end of the
+         * current chunk (or of the body if its length is known).
          *
-         * @param      b   the buffer into which the data is read.
+         * @param      b     the buffer into which the data is read.
+         * @param      off   the start offset in array <code>b</code>
+         *                   at which the data is written.
+         * @param      len   the maximum number of bytes to read.
          * @return     the total number of bytes read into the buffer,
          *             or <code>-1</code> is there is no more data
          *             because the end of the stream has been reached.
          * @exception  IOException  if an I/O error occurs.
-         * @see        java.io.InputStream#read(byte[])
          */
-        public int read(byte[]b) throws IOException {
-            long len = getLength();
+        public synchronized int read(byte[] b, int off, int len) throws IOException {
+            if ((off | len | (off + len) | (b.length - (off + len))) < 0) {
+                throw new IndexOutOfBoundsException();
+            } else if (len == 0) {
+                return 0;
+            }
 
-            if (len != -1) {
-                // More bytes are expected
-                len -= bytesread;
-            } else {
-                // Buffered reading in chunks
-                len = b.length;
+            if (eof || !prepare()) {
+                return -1;
             }
 
-            if (len == 0) {
-                eof = true ;
-                // All expected bytes have been read
+            if (delimited && len > bytesleft) {
+                len = bytesleft;
+            }
+            int n = source.read(b, off, len);
+            if (n == -1) {
+                if (delimited) {
+                    throw new IOException("premature end of response body");
+                }
+                endOfBody(false);
                 return -1;
             }
+            bytesleft -= n;
+            bytesread += n;
+            return n;
+        }
+
+        /**
+         * Reads the remainder of the body into memory and releases the connection
+         * so that the response to a request pipelined behind this one can be read.
+         */
+        synchronized void detach() throws IOException {
+            if (complete) {
+                return;
+            }
+            ByteArrayOutputStream buffer = new ByteArrayOutputStream();
+            byte[] data = new byte[512];
+            int n;
+            while ((n = read(data, 0, data.length)) > 0) {
+                buffer.write(data, 0, n);
+            }
+            source = new ByteArrayInputStream(buffer.toByteArray());
+            bytesleft = buffer.size();
+            chunked = false;
+            delimited = true;
+            eof = false;
+        }
 
-            return read (b, 0, (int)(len < b.length ? len : b.length)) ;
+        /**
+         * Releases the connection when the exchange is closed. The unread
+         * part of a short body is skipped so that the connection can be
+         * reused, otherwise the connection is closed.
+         */
+        synchronized void finish() {
+            try {
+                byte[] data = new byte[512];
+                int skipped = 0;
+                while (!eof && delimited && skipped < DRAIN_LIMIT) {
+                    int n = read(data, 0, data.length);
+                    if (n > 0) {
+                        skipped += n;
+                    }
+                }
+            } catch (IOException e) {
+            }
+            endOfBody(false);
         }
 
         /* Read the chunk size from the input.
@@ -300,7 +449,7 @@ public class Protocol extends ConnectionBase implements HttpConnection {
         private int readChunkSize() throws IOException {
             int size = -1;
             try {
-                String chunk = readLine(streamInput);
+                String chunk = readLine(source);
                 if (chunk == null) {
                     throw new IOException("No Chunk Size");
                 }
@@ -322,6 +471,22 @@ public class Protocol extends ConnectionBase implements HttpConnection {
             return size;
         }
 
+        /*
+         * Skip the (optional) trailer headers and the empty line that
+         * terminate a chunked body.
+         */
+        private void readTrailers() throws IOException {
+            for (;;) {
+                String line = readLine(source);
+                if (line == null) {
+                    throw new IOException("missing chunked body terminator");
+                }
+                if (line.length() == 0) {
+                    return;
+                }
+            }
+        }
+
         /*
          * Read <cr><lf> from the InputStream.
          * @exception IOException is thrown if either <CR> or <LF>
@@ -330,12 +495,12 @@ public class Protocol extends ConnectionBase implements HttpConnection {
         private void readCRLF() throws IOException {
             int ch;
 
-            ch = streamInput.read();
+            ch = source.read();
             if (ch != '\r') {
                 throw new IOException("missing CRLF");
             }
 
-            ch = streamInput.read();
+            ch = source.read();
             if (ch != '\n') {
                 throw new IOException("missing CRLF");
             }
@@ -347,6 +512,15 @@ public class Protocol extends ConnectionBase implements HttpConnection {
 
     } // End of class PrivateInputStream
 
+    /**
+     * Reads the remainder of the response body into memory on behalf of this
+     * exchange. This is called when the response to a request pipelined behind
+     * this one is about to be read from the same connection.
+     */
+    void detachBody() throws IOException {
+        body.detach();
+    }
+
     /**
      * Private OutputStream to allow the buffering of output
      * so the "Content-Length" header can be supplied.
@@ -588,19 +762,65 @@ public class Protocol extends ConnectionBase implements HttpConnection {
 
         if (connected) return;
 
-        // Open socket connection
-        streamConnnection =
-            (StreamConnection)Connector.open("socket://"+host+":"+port);
-
-        // Open data output stream
-        streamOutput = streamConnnection.openDataOutputStream();
-
         // HTTP 1.1 requests must contain content length for proxies
         if (getRequestProperty("Content-Length") == null) {
             setRequestProperty("Content-Length",
                 "" + (out == null ? 0 : out.size()));
         }
 
+        // HTTP 1/1 requests require the Host header to
+        // distinguish virtual host locations.
+        setRequestProperty ("Host" ,  host + ":" + port );
+
+        // Send the request on a pooled connection. If a connection
+        // taken from the idle pool turns out to have been closed by
+        // the server, the request is retried once on a new connection.
+        boolean fresh = false;
+        for (;;) {
+            conn = PersistentConnection.acquire(this, host, port, !method.equals(POST), fresh);
+            streamOutput = conn.output;
+            streamInput = conn.input;
+            try {
+                sendRequest();
+                conn.awaitResponse(this);
+                readResponseMessage(streamInput);
+                break;
+            } catch (IOException e) {
+                boolean retry = !fresh && conn.isRetryable(this);
+                conn.abort(this);
+                conn = null;
+                if (!retry) {
+                    throw e;
+                }
+                fresh = true;
+            }
+        }
+
+        try {
+            readHeaders(streamInput);
+
+            // Ignore a continuation header and read the true headers again.
+            // (Bug# 4382226 discovered with Jetty HTTP 1.1 web server.
+            if (responseCode == 100 ) {
+                readResponseMessage(streamInput);
+                readHeaders(streamInput);
+            }
+
+            connected = true;
+            body = new PrivateInputStream();
+            body.headersRead();
+        } catch (IOException e) {
+            connected = false;
+            conn.abort(this);
+            conn = null;
+            throw e;
+        }
+    }
+
+    /**
+     * Writes the request line, headers and body to the connection.
+     */
+    private void sendRequest() throws IOException {
         String reqLine = method + " " + getFile()
             + (getRef() == null ? "" : "#" + getRef())
             + (getQuery() == null ? "" : "?" + getQuery())
@@ -608,10 +828,6 @@ public class Protocol extends ConnectionBase implements HttpConnection {
 
         streamOutput.write((reqLine).getBytes());
 
-        // HTTP 1/1 requests require the Host header to
-        // distinguish virtual host locations.
-        setRequestProperty ("Host" ,  host + ":" + port );
-
         Enumeration reqKeys = reqProperties.keys();
         while (reqKeys.hasMoreElements()) {
             String key = (String)reqKeys.nextElement();
@@ -623,23 +839,8 @@ public class Protocol extends ConnectionBase implements HttpConnection {
 
         if (out != null) {
             streamOutput.write(out.toByteArray());
-            streamOutput.write("\r\n".getBytes());
         }
         streamOutput.flush();
-
-        streamInput = streamConnnection.openDataInputStream();
-
-        readResponseMessage(streamInput);
-        readHeaders(streamInput);
-
-        // Ignore a continuation header and read the true headers again.
-        // (Bug# 4382226 discovered with Jetty HTTP 1.1 web server.
-        if (responseCode == 100 ) {
-            readResponseMessage(streamInput);
-            readHeaders(streamInput);
-        }
-
-        connected = true;
     }
 
     private void readResponseMessage(InputStream in) throws IOException {
@@ -648,6 +849,7 @@ public class Protocol extends ConnectionBase implements HttpConnection {
 
         responseCode = -1;
         responseMsg = null;
+        responseVersion = null;
 
         malformed: {
             if (line == null)
@@ -685,6 +887,7 @@ public class Protocol extends ConnectionBase implements HttpConnection {
             }
 
             responseMsg = line.substring(codeEnd + 1);
+            responseVersion = httpVer;
             return;
         }
 
@@ -758,11 +961,11 @@ public class Protocol extends ConnectionBase implements HttpConnection {
 
     protected void disconnect() throws IOException {
 
-        if (streamConnnection != null) {
-            streamInput.close();
-            streamOutput.close();
-            streamConnnection.close();
-            streamConnnection = null;
+        if (conn != null) {
+            body.finish();
+            conn = null;
+            streamInput = null;
+            streamOutput = null;
         }
 
         responseCode = -1;
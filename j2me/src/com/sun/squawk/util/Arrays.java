@@ -48,7 +48,9 @@ public class Arrays {
      * @param a the array to be sorted.
      */
     public static void sort(long[] a) {
-    sort1(a, 0, a.length);
+        if (VM.isHosted() || !sortPrimitive(a, 0, a.length)) {
+            sort1(a, 0, a.length);
+        }
     }
 
     /**
@@ -73,7 +75,9 @@ public class Arrays {
      */
     public static void sort(long[] a, int fromIndex, int toIndex) {
         rangeCheck(a.length, fromIndex, toIndex);
-    sort1(a, fromIndex, toIndex-fromIndex);
+        if (VM.isHosted() || !sortPrimitive(a, fromIndex, toIndex)) {
+            sort1(a, fromIndex, toIndex-fromIndex);
+        }
     }
 
     /**
@@ -87,7 +91,9 @@ public class Arrays {
      * @param a the array to be sorted.
      */
     public static void sort(int[] a) {
-    sort1(a, 0, a.length);
+        if (VM.isHosted() || !sortPrimitive(a, 0, a.length)) {
+            sort1(a, 0, a.length);
+        }
     }
 
     /**
@@ -112,7 +118,9 @@ public class Arrays {
      */
     public static void sort(int[] a, int fromIndex, int toIndex) {
         rangeCheck(a.length, fromIndex, toIndex);
-    sort1(a, fromIndex, toIndex-fromIndex);
+        if (VM.isHosted() || !sortPrimitive(a, fromIndex, toIndex)) {
+            sort1(a, fromIndex, toIndex-fromIndex);
+        }
     }
 
     /**
@@ -126,7 +134,9 @@ public class Arrays {
      * @param a the array to be sorted.
      */
     public static void sort(short[] a) {
-    sort1(a, 0, a.length);
+        if (VM.isHosted() || !sortPrimitive(a, 0, a.length)) {
+            sort1(a, 0, a.length);
+        }
     }
 
     /**
@@ -151,7 +161,9 @@ public class Arrays {
      */
     public static void sort(short[] a, int fromIndex, int toIndex) {
         rangeCheck(a.length, fromIndex, toIndex);
-    sort1(a, fromIndex, toIndex-fromIndex);
+        if (VM.isHosted() || !sortPrimitive(a, fromIndex, toIndex)) {
+            sort1(a, fromIndex, toIndex-fromIndex);
+        }
     }
 
     /**
@@ -165,7 +177,9 @@ public class Arrays {
      * @param a the array to be sorted.
      */
     public static void sort(char[] a) {
-    sort1(a, 0, a.length);
+        if (VM.isHosted() || !sortPrimitive(a, 0, a.length)) {
+            sort1(a, 0, a.length);
+        }
     }
 
     /**
@@ -190,7 +204,9 @@ public class Arrays {
      */
     public static void sort(char[] a, int fromIndex, int toIndex) {
         rangeCheck(a.length, fromIndex, toIndex);
-    sort1(a, fromIndex, toIndex-fromIndex);
+        if (VM.isHosted() || !sortPrimitive(a, fromIndex, toIndex)) {
+            sort1(a, fromIndex, toIndex-fromIndex);
+        }
     }
 
     /**
@@ -204,7 +220,9 @@ public class Arrays {
      * @param a the array to be sorted.
      */
     public static void sort(byte[] a) {
-    sort1(a, 0, a.length);
+        if (VM.isHosted() || !sortPrimitive(a, 0, a.length)) {
+            sort1(a, 0, a.length);
+        }
     }
 
     /**
@@ -229,7 +247,9 @@ public class Arrays {
      */
     public static void sort(byte[] a, int fromIndex, int toIndex) {
         rangeCheck(a.length, fromIndex, toIndex);
-    sort1(a, fromIndex, toIndex-fromIndex);
+        if (VM.isHosted() || !sortPrimitive(a, fromIndex, toIndex)) {
+            sort1(a, fromIndex, toIndex-fromIndex);
+        }
     }
 
 /*if[FLOATS]*/
@@ -1227,7 +1247,7 @@ public class Arrays {
         rangeCheck(a.length, fromIndex, toIndex);
 //        Object aux[] = (Object[])a.clone();
         Object aux[] = new Object[a.length];
-        System.arraycopy(a, 0, aux, 0, aux.length);
+        System.arraycopy(a, fromIndex, aux, fromIndex, toIndex-fromIndex);
 //        if (c==null)
 //            mergeSort(aux, a, fromIndex, toIndex);
 //        else
@@ -1238,11 +1258,24 @@ public class Arrays {
                                   int low, int high, Comparer c) {
     int length = high - low;
 
-    // Insertion sort on smallest arrays
+    // Binary insertion sort on smallest arrays. An element is inserted
+    // after all the elements equal to it to keep the sort stable.
     if (length < 7) {
-        for (int i=low; i<high; i++)
-        for (int j=i; j>low && c.compare(dest[j-1], dest[j])>0; j--)
-            swap(dest, j, j-1);
+        for (int i=low+1; i<high; i++) {
+            Object pivot = dest[i];
+            int left = low;
+            int right = i;
+            while (left < right) {
+                int mid = (left + right) >> 1;
+                if (c.compare(pivot, dest[mid]) < 0)
+                    right = mid;
+                else
+                    left = mid + 1;
+            }
+            for (int j=i; j>left; j--)
+                dest[j] = dest[j-1];
+            dest[left] = pivot;
+        }
         return;
     }
 
@@ -1304,6 +1337,9 @@ public class Arrays {
      * @see #sort(long[])
      */
     public static int binarySearch(long[] a, long key) {
+        if (!VM.isHosted()) {
+            return binarySearchPrimitive(a, 0, a.length, key);
+        }
     int low = 0;
     int high = a.length-1;
 
@@ -1343,6 +1379,9 @@ public class Arrays {
      * @see #sort(int[])
      */
     public static int binarySearch(int[] a, int key) {
+        if (!VM.isHosted()) {
+            return binarySearchPrimitive(a, 0, a.length, key);
+        }
     int low = 0;
     int high = a.length-1;
 
@@ -1381,6 +1420,9 @@ public class Arrays {
      * @see #sort(short[])
      */
     public static int binarySearch(short[] a, short key) {
+        if (!VM.isHosted()) {
+            return binarySearchPrimitive(a, 0, a.length, key);
+        }
     int low = 0;
     int high = a.length-1;
 
@@ -1419,6 +1461,9 @@ public class Arrays {
      * @see #sort(char[])
      */
     public static int binarySearch(char[] a, char key) {
+        if (!VM.isHosted()) {
+            return binarySearchPrimitive(a, 0, a.length, key);
+        }
     int low = 0;
     int high = a.length-1;
 
@@ -1457,6 +1502,9 @@ public class Arrays {
      * @see #sort(byte[])
      */
     public static int binarySearch(byte[] a, byte key) {
+        if (!VM.isHosted()) {
+            return binarySearchPrimitive(a, 0, a.length, key);
+        }
     int low = 0;
     int high = a.length-1;
 
@@ -1916,6 +1964,9 @@ public class Arrays {
         if (a2.length != length)
             return false;
 
+        if (!VM.isHosted())
+            return equalsPrimitive(a, a2, length);
+
         for (int i=0; i<length; i++)
             if (a[i] != a2[i])
                 return false;
@@ -1945,6 +1996,9 @@ public class Arrays {
         if (a2.length != length)
             return false;
 
+        if (!VM.isHosted())
+            return equalsPrimitive(a, a2, length);
+
         for (int i=0; i<length; i++)
             if (a[i] != a2[i])
                 return false;
@@ -1974,6 +2028,9 @@ public class Arrays {
         if (a2.length != length)
             return false;
 
+        if (!VM.isHosted())
+            return equalsPrimitive(a, a2, length);
+
         for (int i=0; i<length; i++)
             if (a[i] != a2[i])
                 return false;
@@ -2003,6 +2060,9 @@ public class Arrays {
         if (a2.length != length)
             return false;
 
+        if (!VM.isHosted())
+            return equalsPrimitive(a, a2, length);
+
         for (int i=0; i<length; i++)
             if (a[i] != a2[i])
                 return false;
@@ -2032,6 +2092,9 @@ public class Arrays {
         if (a2.length != length)
             return false;
 
+        if (!VM.isHosted())
+            return equalsPrimitive(a, a2, length);
+
         for (int i=0; i<length; i++)
             if (a[i] != a2[i])
                 return false;
@@ -2061,6 +2124,9 @@ public class Arrays {
         if (a2.length != length)
             return false;
 
+        if (!VM.isHosted())
+            return equalsPrimitive(a, a2, length);
+
         for (int i=0; i<length; i++)
             if (a[i] != a2[i])
                 return false;
@@ -2398,6 +2464,10 @@ public class Arrays {
      */
     public static void fill(long[] a, int fromIndex, int toIndex, long val) {
         rangeCheck(a.length, fromIndex, toIndex);
+        if (!VM.isHosted()) {
+            fillPrimitive(a, fromIndex, toIndex, val);
+            return;
+        }
         for (int i=fromIndex; i<toIndex; i++)
             a[i] = val;
     }
@@ -2432,6 +2502,10 @@ public class Arrays {
      */
     public static void fill(int[] a, int fromIndex, int toIndex, int val) {
         rangeCheck(a.length, fromIndex, toIndex);
+        if (!VM.isHosted()) {
+            fillPrimitive(a, fromIndex, toIndex, val);
+            return;
+        }
         for (int i=fromIndex; i<toIndex; i++)
             a[i] = val;
     }
@@ -2466,6 +2540,10 @@ public class Arrays {
      */
     public static void fill(short[] a, int fromIndex, int toIndex, short val) {
         rangeCheck(a.length, fromIndex, toIndex);
+        if (!VM.isHosted()) {
+            fillPrimitive(a, fromIndex, toIndex, val);
+            return;
+        }
         for (int i=fromIndex; i<toIndex; i++)
             a[i] = val;
     }
@@ -2500,6 +2578,10 @@ public class Arrays {
      */
     public static void fill(char[] a, int fromIndex, int toIndex, char val) {
         rangeCheck(a.length, fromIndex, toIndex);
+        if (!VM.isHosted()) {
+            fillPrimitive(a, fromIndex, toIndex, val);
+            return;
+        }
         for (int i=fromIndex; i<toIndex; i++)
             a[i] = val;
     }
@@ -2534,6 +2616,10 @@ public class Arrays {
      */
     public static void fill(byte[] a, int fromIndex, int toIndex, byte val) {
         rangeCheck(a.length, fromIndex, toIndex);
+        if (!VM.isHosted()) {
+            fillPrimitive(a, fromIndex, toIndex, val);
+            return;
+        }
         for (int i=fromIndex; i<toIndex; i++)
             a[i] = val;
     }
@@ -2569,6 +2655,10 @@ public class Arrays {
     public static void fill(boolean[] a, int fromIndex, int toIndex,
                             boolean val) {
         rangeCheck(a.length, fromIndex, toIndex);
+        if (!VM.isHosted()) {
+            fillPrimitive(a, fromIndex, toIndex, val ? 1 : 0);
+            return;
+        }
         for (int i=fromIndex; i<toIndex; i++)
             a[i] = val;
     }
@@ -2678,4 +2768,55 @@ public class Arrays {
         for (int i=fromIndex; i<toIndex; i++)
             a[i] = val;
     }
+
+    // Native kernels
+
+    /*
+     * The following methods are implemented by the VM for arrays of the integral
+     * primitive types and booleans. They must not be called when running hosted
+     * as there is no Squawk interpreter to execute them.
+     */
+
+    /**
+     * Sorts a range of a primitive array into ascending numerical order.
+     *
+     * @param array the array to be sorted
+     * @param fromIndex the index of the first element (inclusive) to be sorted
+     * @param toIndex the index of the last element (exclusive) to be sorted
+     * @return false if the VM could not allocate the memory needed for the sort
+     *         in which case the array is unchanged
+     */
+    private native static boolean sortPrimitive(Object array, int fromIndex, int toIndex);
+
+    /**
+     * Searches a range of a sorted primitive array for a value. The same elements
+     * are probed as by the Java implementation of the binary search.
+     *
+     * @param array the array to be searched
+     * @param fromIndex the index of the first element (inclusive) to be searched
+     * @param toIndex the index of the last element (exclusive) to be searched
+     * @param key the value to be searched for
+     * @return the index of the key or <tt>(-(<i>insertion point</i>) - 1)</tt>
+     */
+    private native static int binarySearchPrimitive(Object array, int fromIndex, int toIndex, long key);
+
+    /**
+     * Compares the first elements of two primitive arrays of the same type.
+     *
+     * @param a one array to be tested for equality
+     * @param a2 the other array to be tested for equality
+     * @param length the number of elements to compare
+     * @return true if the elements are equal
+     */
+    private native static boolean equalsPrimitive(Object a, Object a2, int length);
+
+    /**
+     * Assigns a value to each element of a range of a primitive array.
+     *
+     * @param array the array to be filled
+     * @param fromIndex the index of the first element (inclusive) to be filled
+     * @param toIndex the index of the last element (exclusive) to be filled
+     * @param value the value to be stored, truncated to the element type
+     */
+    private native static void fillPrimitive(Object array, int fromIndex, int toIndex, long value);
 }
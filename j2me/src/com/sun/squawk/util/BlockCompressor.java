@@ -0,0 +1,187 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ */
+package com.sun.squawk.util;
+
+/**
+ * A simple LZ77 style compressor for blocks of at most {@link #BLOCK_SIZE} bytes.
+ * Each block is compressed independently so that a stream of blocks can be
+ * decompressed one block at a time.
+ * <p>
+ * The compressed form of a block is a sequence of groups. A group starts with a
+ * flags byte followed by up to 8 items. If bit <i>n</i> of the flags byte is 0 then
+ * item <i>n</i> is a literal byte, otherwise it is a 2 byte back reference to a
+ * previous sequence of bytes in the block. A back reference encodes the distance
+ * (1 to 4096) minus 1 in its high 12 bits and the length (3 to 18) minus 3 in its
+ * low 4 bits.
+ */
+public final class BlockCompressor {
+
+    /**
+     * The maximum number of bytes in a block.
+     */
+    public static final int BLOCK_SIZE = 4096;
+
+    /**
+     * The size of a buffer that is large enough to hold any compressed block.
+     */
+    public static final int MAX_COMPRESSED_SIZE = BLOCK_SIZE + (BLOCK_SIZE / 8) + 1;
+
+    /**
+     * The minimum and maximum length of a back reference.
+     */
+    private static final int MIN_MATCH = 3;
+    private static final int MAX_MATCH = MIN_MATCH + 15;
+
+    /**
+     * The maximum distance of a back reference.
+     */
+    private static final int MAX_DISTANCE = 4096;
+
+    /**
+     * The number of bits in the hash of the first MIN_MATCH bytes of a sequence.
+     */
+    private static final int HASH_BITS = 12;
+
+    /**
+     * The position of the last sequence seen for each hash value.
+     */
+    private final int[] table = new int[1 << HASH_BITS];
+
+    /**
+     * Computes the hash of the MIN_MATCH bytes at a given position.
+     *
+     * @param buf  the bytes
+     * @param pos  the position
+     * @return the hash
+     */
+    private static int hash(byte[] buf, int pos) {
+        int h = ((buf[pos] & 0xFF) << 16) | ((buf[pos + 1] & 0xFF) << 8) | (buf[pos + 2] & 0xFF);
+        return ((h * 0x9E3779B1) >>> (32 - HASH_BITS));
+    }
+
+    /**
+     * Compresses a block.
+     *
+     * @param src     the block to compress
+     * @param length  the number of bytes in the block
+     * @param dst     the buffer into which the compressed block is written. It must be
+     *                at least {@link #MAX_COMPRESSED_SIZE} bytes long
+     * @return the length of the compressed block
+     */
+    public int compress(byte[] src, int length, byte[] dst) {
+        Assert.that(length <= BLOCK_SIZE && dst.length >= MAX_COMPRESSED_SIZE);
+        for (int i = 0; i != table.length; ++i) {
+            table[i] = -1;
+        }
+
+        int in = 0;
+        int out = 0;
+        while (in < length) {
+            int flagsPos = out++;
+            int flags = 0;
+            for (int bit = 0; bit != 8 && in < length; ++bit) {
+                int matchLength = 0;
+                int candidate = -1;
+                if (in + MIN_MATCH <= length) {
+                    int h = hash(src, in);
+                    candidate = table[h];
+                    table[h] = in;
+                    if (candidate >= 0 && in - candidate <= MAX_DISTANCE) {
+                        int max = Math.min(MAX_MATCH, length - in);
+                        while (matchLength < max && src[candidate + matchLength] == src[in + matchLength]) {
+                            ++matchLength;
+                        }
+                    }
+                }
+                if (matchLength >= MIN_MATCH) {
+                    int distance = in - candidate - 1;
+                    flags |= 1 << bit;
+                    dst[out++] = (byte)(distance >> 4);
+                    dst[out++] = (byte)((distance << 4) | (matchLength - MIN_MATCH));
+                    for (int i = in + 1; i != in + matchLength && i + MIN_MATCH <= length; ++i) {
+                        table[hash(src, i)] = i;
+                    }
+                    in += matchLength;
+                } else {
+                    dst[out++] = src[in++];
+                }
+            }
+            dst[flagsPos] = (byte)flags;
+        }
+        return out;
+    }
+
+    /**
+     * Decompresses a block.
+     *
+     * @param src        the compressed block
+     * @param srcLength  the length of the compressed block
+     * @param dst        the buffer into which the block is decompressed
+     * @param dstOffset  the offset in <code>dst</code> at which the block starts
+     * @param length     the number of bytes in the decompressed block
+     * @return false if the compressed block is malformed
+     */
+    public static boolean decompress(byte[] src, int srcLength, byte[] dst, int dstOffset, int length) {
+        int in = 0;
+        int out = dstOffset;
+        int end = dstOffset + length;
+        while (out != end) {
+            if (in == srcLength) {
+                return false;
+            }
+            int flags = src[in++] & 0xFF;
+            for (int bit = 0; bit != 8 && out != end; ++bit) {
+                if ((flags & (1 << bit)) != 0) {
+                    if (in + 2 > srcLength) {
+                        return false;
+                    }
+                    int hi = src[in++] & 0xFF;
+                    int lo = src[in++] & 0xFF;
+                    int from = out - (((hi << 4) | (lo >> 4)) + 1);
+                    int matchLength = (lo & 0x0F) + MIN_MATCH;
+                    if (from < dstOffset || matchLength > end - out) {
+                        return false;
+                    }
+                    while (matchLength-- != 0) {
+                        dst[out++] = dst[from++];
+                    }
+                } else {
+                    if (in == srcLength) {
+                        return false;
+                    }
+                    dst[out++] = src[in++];
+                }
+            }
+        }
+        return in == srcLength;
+    }
+
+    /**
+     * Computes the Adler-32 checksum of a range of bytes.
+     *
+     * @param buf     the bytes
+     * @param offset  the offset of the first byte
+     * @param length  the number of bytes
+     * @return the checksum
+     */
+    public static int checksum(byte[] buf, int offset, int length) {
+        int a = 1;
+        int b = 0;
+        int end = offset + length;
+        while (offset != end) {
+            // 5552 is the largest n such that the sums cannot overflow before being reduced
+            int chunkEnd = Math.min(end, offset + 5552);
+            while (offset != chunkEnd) {
+                a += buf[offset++] & 0xFF;
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+        }
+        return (b << 16) | a;
+    }
+}
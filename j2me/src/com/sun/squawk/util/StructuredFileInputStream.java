@@ -89,6 +89,28 @@ public abstract class StructuredFileInputStream {
         }
     }
 
+    /**
+     * Reads <code>len</code> bytes from the class file and stores them into the buffer
+     * array <code>b</code> starting at <code>off</code>.
+     *
+     * @param  b       the buffer to fill
+     * @param  off     the offset in <code>b</code> of the first byte read
+     * @param  len     the number of bytes to read
+     * @param   prefix  the optional prefix used when tracing this read
+     */
+    public final void readFully(byte[] b, int off, int len, String prefix) {
+        try {
+            in.readFully(b, off, len);
+            if (Klass.DEBUG && prefix != null && Tracer.isTracing(traceFeature, filePath)) {
+                Tracer.traceln(prefix + ":{read " + len + " bytes}");
+            }
+        } catch (EOFException oef) {
+            throw formatError("truncated file");
+        } catch (IOException ioe) {
+            throw formatError(ioe.toString());
+        }
+    }
+
     /**
      * Reads an integer from the class file.
      *
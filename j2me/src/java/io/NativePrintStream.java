@@ -10,11 +10,16 @@ package java.io;
 
 public class NativePrintStream extends PrintStream {
 
+    /**
+     * The VM stream to which this print stream writes.
+     */
+    private final int stream = VM.STREAM_STDOUT;
 
     public NativePrintStream() {
     }
 
     public void flush() {
+        VM.flush(stream);
     }
 
     public void close() {
@@ -41,11 +46,15 @@ public class NativePrintStream extends PrintStream {
     }
 
     protected void write(String s) {
+        int old = VM.setStream(stream);
         VM.print(s);
+        VM.setStream(old);
     }
 
     protected void newLine() {
+        int old = VM.setStream(stream);
         VM.println();
+        VM.setStream(old);
     }
 
 
@@ -32,6 +32,21 @@ public class FlashObjectMemoryLoader extends ObjectMemoryLoader {
       return null;
    }
 
+   /**
+    * The memory of a suite in flash is used in place, so it can be neither
+    * compressed nor a delta from another object memory.
+    */
+   protected int loadAttributes() {
+      int attributes = super.loadAttributes();
+      if ((attributes & ATTRIBUTE_COMPRESSED) != 0) {
+         throw new LinkageError("object memory in flash cannot be compressed");
+      }
+      if ((attributes & ATTRIBUTE_DELTA) != 0) {
+         throw new LinkageError("object memory in flash cannot be a delta");
+      }
+      return attributes;
+   }
+
    protected byte[] loadMemory(ObjectMemory parent, int size) {
       // record the current address of the reader (this is the location of memory)
       // round up to a word boundary
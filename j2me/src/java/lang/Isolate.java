@@ -53,7 +53,7 @@ public final class Isolate implements Runnable {
     /**
      * The command line arguments for the class to be executed.
      */
-    private final String[] args;
+    private String[] args;
 
     /**
      * The suite into which any dynamically loaded classes are installed.
@@ -183,6 +183,22 @@ public final class Isolate implements Runnable {
      */
     private final boolean isTckTest;
 
+    /**
+     * Specifies if the isolate hibernates itself once its main class has been
+     * initialized and just before the main method is called.
+     */
+    private boolean hibernateBeforeMain;
+
+    /**
+     * The digest of the 'memory' component (in canonical form) of the object memory most
+     * recently written by an incremental {@link #save(String, boolean) save} of this isolate
+     * and the URLs of the chain of files needed to reconstruct it, the most recently written
+     * one last. The next incremental save only writes the blocks that differ from this image.
+     * These fields are cleared while the isolate is being serialized.
+     */
+    private ObjectMemorySerializer.MemoryDigest savedDigest;
+    private String[] savedImageURLs;
+
     /**
      * Creates the root isolate.
      *
@@ -261,6 +277,30 @@ public final class Isolate implements Runnable {
         return args;
     }
 
+    /**
+     * Replaces the arguments that will be passed to the main method. This can only be
+     * done for an isolate that has not yet called its main method.
+     *
+     * @param args  the new arguments
+     */
+    void setMainClassArguments(String[] args) {
+        Assert.that(state == NEW || hibernateBeforeMain);
+        this.args = args;
+    }
+
+    /**
+     * Requests that this isolate hibernate itself once its main class has been loaded
+     * and initialized. Saving the hibernated isolate then produces a warm image of the
+     * application that can be {@link #load(String) loaded} and {@link #unhibernate() resumed}
+     * any number of times, skipping the class loading and initialization done at startup.
+     * The I/O system is not hibernated so any connection opened by a class initializer
+     * is not usable after a resume.
+     */
+    void setHibernateBeforeMain() {
+        Assert.that(state == NEW);
+        hibernateBeforeMain = true;
+    }
+
     /**
      * Gets the bootstrap suite.
      *
@@ -699,6 +739,19 @@ Suite openSuiteHack;
             exit(999);
         }
 
+        /*
+         * Hibernate now if a warm image was requested. This only returns
+         * once the (possibly reloaded) isolate is unhibernated.
+         */
+        if (hibernateBeforeMain) {
+            try {
+                hibernate(false, HIBERNATED);
+            } catch (IOException e) {
+                Assert.shouldNotReachHere();
+            }
+            hibernateBeforeMain = false;
+        }
+
         klass.main(args);
 
         System.out.flush();
@@ -844,23 +897,103 @@ Suite openSuiteHack;
      *         some other IO problem while writing the file.
      */
     public String save() throws java.io.IOException {
+        return save("file://" + hibernatedContext + ".isolate");
+    }
+
+    /**
+     * Serializes and saves to a given URL the object graph rooted by this hibernated isolate.
+     *
+     * @param url  the URL to which the isolate is saved
+     * @return <code>url</code>
+     * @throws IOException if there was insufficient memory to do the save or there was
+     *         some other IO problem while writing the file.
+     */
+    public String save(String url) throws java.io.IOException {
+        return save(url, false);
+    }
+
+    /**
+     * Serializes and saves to a given URL the object graph rooted by this hibernated isolate.
+     * An incremental save that follows another incremental save of this isolate only
+     * writes the parts of the serialized graph that have changed since then. The file
+     * written by the previous save must remain available for the new one to be
+     * {@link #load loaded}. Note that the graph is still completely serialized in memory.
+     * Only a {@link ObjectMemorySerializer.MemoryDigest digest} of it is retained until the
+     * next save.
+     * <p>
+     * A complete image is written in compressed form if the isolate property
+     * "com.sun.squawk.isolate.compress" is "true".
+     *
+     * @param url          the URL to which the isolate is saved
+     * @param incremental  specifies if only the changes since the last incremental save should be written
+     * @return <code>url</code>
+     * @throws IOException if there was insufficient memory to do the save or there was
+     *         some other IO problem while writing the file.
+     */
+    public String save(String url, boolean incremental) throws java.io.IOException {
         Assert.that(state == HIBERNATED);
 
         // Null out the interned string cache as it will be rebuilt on demand
         internedStrings = null;
 
+        // Exclude the digest of the previously saved image from the graph
+        ObjectMemorySerializer.MemoryDigest baseDigest = savedDigest;
+        String[] baseURLs = savedImageURLs;
+        savedDigest = null;
+        savedImageURLs = null;
+
         ObjectMemorySerializer.ControlBlock cb = VM.copyObjectGraph(this);
+
+        // Restore the previously saved digest so that a failed copy leaves it intact
+        savedDigest = baseDigest;
+        savedImageURLs = baseURLs;
         if (cb == null) {
             throw new java.io.IOException("insufficient memory for object graph copying");
         }
-        String url = "file://" + hibernatedContext+ ".isolate";
 
         Suite readOnlySuite = openSuite;
         while (GC.inRam(readOnlySuite)) {
             readOnlySuite = readOnlySuite.getParent();
         }
 
-        ObjectMemorySerializer.save(url, cb, GC.lookupObjectMemoryByRoot(readOnlySuite));
+        // A delta cannot overwrite any file in the chain it is reconstructed from
+        String baseURL = null;
+        if (incremental && baseURLs != null) {
+            baseURL = baseURLs[baseURLs.length - 1];
+            for (int i = 0; i != baseURLs.length; ++i) {
+                if (url.equals(baseURLs[i])) {
+                    baseURL = null;
+                    break;
+                }
+            }
+        }
+        if (baseURL == null) {
+            baseDigest = null;
+            baseURLs = null;
+            savedDigest = null;
+            savedImageURLs = null;
+        }
+
+        ObjectMemorySerializer.MemoryDigest digest = null;
+        if (incremental) {
+            digest = new ObjectMemorySerializer.MemoryDigest(cb.memory, cb.size);
+        }
+
+        boolean compress = baseURL == null && "true".equals(getProperty("com.sun.squawk.isolate.compress"));
+        ObjectMemorySerializer.save(url, cb, GC.lookupObjectMemoryByRoot(readOnlySuite), baseURL, baseDigest, digest, compress);
+
+        if (incremental) {
+            String[] urls;
+            if (baseURLs == null) {
+                urls = new String[1];
+            } else {
+                urls = new String[baseURLs.length + 1];
+                System.arraycopy(baseURLs, 0, urls, 0, baseURLs.length);
+            }
+            urls[urls.length - 1] = url;
+            savedDigest = digest;
+            savedImageURLs = urls;
+        }
         return url;
     }
 
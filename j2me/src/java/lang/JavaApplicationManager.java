@@ -40,6 +40,16 @@ public class JavaApplicationManager {
      */
     private static boolean hibernatetest;
 
+    /**
+     * The URL to which a warm image of the application is saved (if any).
+     */
+    private static String snapshotURL;
+
+    /**
+     * The URL from which a warm image of the application is restored (if any).
+     */
+    private static String restoreURL;
+
     /**
      * Main routine.
      *
@@ -55,19 +65,19 @@ public class JavaApplicationManager {
         }
 
         /*
-         * Check that there is a main class specified.
+         * If this VM is a zygote then the options processed so far become the defaults
+         * for every launch request. Only the child process forked for a request returns.
          */
-        if (args.length == 0) {
-            usage("");
+        String[] request = VM.awaitLaunchRequest();
+        if (request != null) {
+            args = request.length != 0 ? processVMOptions(request) : request;
         }
 
         /*
-         * Split out the class name from the other arguments.
+         * Check that there is a main class specified.
          */
-        String mainClassName = args[0].replace('/', '.');
-        String[] javaArgs = new String[args.length - 1];
-        for (int i = 0 ; i < javaArgs.length ; i++) {
-            javaArgs[i] = args[i+1];
+        if (args.length == 0 && restoreURL == null) {
+            usage("");
         }
 
         /*
@@ -75,15 +85,39 @@ public class JavaApplicationManager {
          */
         long startTime = System.currentTimeMillis();
 
-        /*
-         * Create the application isolate and run it.
-         */
-        Isolate isolate = new Isolate(mainClassName, javaArgs, classPath, parentSuiteURL);
+        Isolate isolate;
+        if (restoreURL != null) {
+
+            /*
+             * Load the warm image and resume it with all the arguments passed to its main method.
+             */
+            isolate = Isolate.load(restoreURL);
+            isolate.setMainClassArguments(args);
+            isolate.unhibernate();
+        } else {
+
+            /*
+             * Split out the class name from the other arguments.
+             */
+            String mainClassName = args[0].replace('/', '.');
+            String[] javaArgs = new String[args.length - 1];
+            for (int i = 0 ; i < javaArgs.length ; i++) {
+                javaArgs[i] = args[i+1];
+            }
+
+            /*
+             * Create the application isolate and start it.
+             */
+            isolate = new Isolate(mainClassName, javaArgs, classPath, parentSuiteURL);
+            if (snapshotURL != null) {
+                isolate.setHibernateBeforeMain();
+            }
+            isolate.start();
+        }
 
         /*
-         * Start the isolate and wait for it to complete.
+         * Wait for the isolate to complete.
          */
-        isolate.start();
         isolate.join();
 
         /*
@@ -91,7 +125,11 @@ public class JavaApplicationManager {
          */
         if (isolate.isHibernated()) {
             try {
-                System.out.println("Saved isolate to " + isolate.save());
+                if (snapshotURL != null) {
+                    System.out.println("Saved warm image to " + isolate.save(snapshotURL));
+                } else {
+                    System.out.println("Saved isolate to " + isolate.save());
+                }
             } catch (java.io.IOException ioe) {
                 System.err.println("I/O error while trying to save isolate: ");
                 ioe.printStackTrace();
@@ -264,6 +302,10 @@ public class JavaApplicationManager {
             }
         } else if (arg.equals("-hibernatetest")) {
             hibernatetest = true;
+        } else if (arg.startsWith("-snapshot:")) {
+            snapshotURL = "file://" + arg.substring("-snapshot:".length());
+        } else if (arg.startsWith("-restore:")) {
+            restoreURL = "file://" + arg.substring("-restore:".length());
         } else if (arg.equals("-stats")) {
             displayExecutionStatistics = true;
         } else if (arg.equals("-h")) {
@@ -336,6 +378,7 @@ public class JavaApplicationManager {
             out.println("** " + msg + " **\n");
         }
         out.println("Usage: squawk [-options] class [args...]");
+        out.println("   or: squawk [-options] -restore:<file> [args...]");
         out.println();
         out.println("where options include:");
         out.println("    -cp:<directories and jar/zip files separated by ':' (Unix) or ';' (Windows)>");
@@ -351,6 +394,9 @@ public class JavaApplicationManager {
         GC.getCollector().usage(out);
         out.println("    -egc                    enable excessive garbage collection");
         out.println("    -nogc                   disable application calls to Runtime.gc()");
+        out.println("    -snapshot:<file>        initialize the main class then save a warm image of the");
+        out.println("                            application to <file> instead of running it");
+        out.println("    -restore:<file>         run the application in the warm image saved in <file>");
         out.println("    -stats                  display execution statistics before exiting");
         out.println("    -h                      display this help message");
         out.println("    -X                      display help on native VM options");
@@ -199,6 +199,16 @@ public class Klass {
      */
     private UWord oopMapWord;
 
+    /**
+     * The values of the static fields computed at romize time by evaluating the
+     * <code>&lt;clinit&gt;</code> method of this class. If this is non-null then
+     * the class is initialized by copying these values into its class state instead
+     * of calling <code>&lt;clinit&gt;</code>. The first {@link #refStaticFieldsSize}
+     * entries are the values of the reference static fields and the last entry is
+     * an <code>int[]</code> holding the values of the primitive static fields.
+     */
+    private Object[] clinitTemplate;
+
     /**
      * The class identifier.
      */
@@ -1315,6 +1325,24 @@ public class Klass {
         return virtualMethods;
     }
 
+    /**
+     * Get the table of static methods.
+     *
+     * @return the static methods table
+     */
+    final Object[] getStaticMethods() {
+        return staticMethods;
+    }
+
+    /**
+     * Get the object table.
+     *
+     * @return the object table
+     */
+    final Object[] getObjectTable() {
+        return objects;
+    }
+
     /**
      * Gets a string representation of a given field or method. If
      * <code>member</code> is a field, then the returned string will be the
@@ -2047,6 +2075,33 @@ public class Klass {
         klassmetadata.setMethodMetadata(isStatic, index, body.getMetadata());
     }
 
+    /**
+     * Sets the values of the static fields of this class as computed by evaluating its
+     * <code>&lt;clinit&gt;</code> method at romize time. Static fields not in
+     * <code>fields</code> are initialized to their default values.
+     *
+     * @param fields   the static fields initialized by <code>&lt;clinit&gt;</code>
+     * @param values   the values of <code>fields</code>. The value of a primitive field is an <code>Integer</code>
+     */
+    public void setClinitTemplate(Field[] fields, Object[] values) {
+        Assert.that(VM.isHosted() && indexForClinit != -1);
+        int refCount = refStaticFieldsSize;
+        Object[] template = new Object[refCount + 1];
+        int[] primitives = new int[staticFieldsSize - refCount];
+        for (int i = 0 ; i < fields.length ; i++) {
+            Field field = fields[i];
+            int offset = field.getOffset();
+            Assert.that(field.getDefiningClass() == this && field.isStatic() && offset < staticFieldsSize);
+            if (field.getType().isPrimitive()) {
+                primitives[offset - refCount] = ((Integer)values[i]).intValue();
+            } else {
+                template[offset] = values[i];
+            }
+        }
+        template[refCount] = primitives;
+        clinitTemplate = template;
+    }
+
     /**
      * Get the source file from which the class was compiled.
      *
@@ -2775,7 +2830,11 @@ public class Klass {
          * Step 8
          */
         try {
-            clinit();
+            if (clinitTemplate != null) {
+                initializeFromTemplate(getInitializationClassState());
+            } else {
+                clinit();
+            }
             /*
              * Step 9
              */
@@ -2848,6 +2907,40 @@ public class Klass {
         }
     }
 
+    /**
+     * Initializes the static fields of this class from the values computed at romize
+     * time instead of calling its <code>&lt;clinit&gt;</code> method. The template is
+     * shared by all isolates so each one gets its own copy of any array in it.
+     *
+     * @param cs  the class state of this class
+     */
+    private void initializeFromTemplate(Object cs) {
+        Object[] template = clinitTemplate;
+        int refCount = template.length - 1;
+
+        // Verbose trace.
+        if (VM.isVeryVerbose()) {
+              VM.print("[initializing class ");
+              VM.print(name);
+              VM.println(" from template]");
+        }
+
+        for (int i = 0 ; i < refCount ; i++) {
+            Object value = template[i];
+            if (value != null && GC.getKlass(value).isArray()) {
+                int length = GC.getArrayLength(value);
+                Object copy = GC.newArray(GC.getKlass(value), length);
+                System.arraycopy(value, 0, copy, 0, length);
+                value = copy;
+            }
+            Unsafe.setObject(cs, CS.firstVariable + i, value);
+        }
+        int[] primitives = (int[])template[refCount];
+        for (int i = 0 ; i < primitives.length ; i++) {
+            Unsafe.setUWord(cs, CS.firstVariable + refCount + i, UWord.fromPrimitive(primitives[i]));
+        }
+    }
+
 
     /*---------------------------------------------------------------------------*\
      *                           Bootstrap classes                               *
@@ -298,15 +298,18 @@ public final class MethodBody {
      *              minfo_size relocation_table_size;   // exists only if 'R' bit in 'fmt' is set
      *              minfo_size exception_table_size;    // exists only if 'E' bit in 'fmt' is set
      *              minfo_size parameters_count;
-     *              minfo_size locals_count;
-     *              minfo_size max_stack;
+     *              minfo_u2   locals_count;
+     *              minfo_u2   max_stack;
      *              u1 fmt;                             // 10000TRE
      *          } large_minfo;
      *      }
      *  }
      *
      * The minfo_size type is a u1 value if its high bit is 0, otherwise its a u2 value where
-     * the high bit is masked off.
+     * the high bit is masked off. The minfo_u2 type is a minfo_size value that is always
+     * written in its u2 form. This places the locals count and stack count of a large minfo
+     * at fixed offsets from the method pointer so that they can be read without decoding
+     * the preceding entries when a frame is set up.
      *
      * </pre></blockquote><hr><p>
      *
@@ -421,8 +424,8 @@ public final class MethodBody {
                 fmt |= FMT_E;
             }
             writeMinfoSize(enc, parametersCount);
-            writeMinfoSize(enc, localsCount);
-            writeMinfoSize(enc, maxStack);
+            writeMinfoU2(enc, localsCount);
+            writeMinfoU2(enc, maxStack);
             enc.addUnsignedByte(fmt);
         }
     }
@@ -456,6 +459,19 @@ public final class MethodBody {
         }
     }
 
+    /**
+     * Write a length into the minfo using the u2 form of a minfo_size
+     * regardless of its value.
+     *
+     * @param enc the encoder
+     * @param value the value
+     */
+    private void writeMinfoU2(ByteBufferEncoder enc, int value) {
+        Assert.that(value < 32768);
+        enc.addUnsignedByte(value & 0xFF);
+        enc.addUnsignedByte(0x80|(value>>8));
+    }
+
     /**
      * Return size of the method byte array.
      *
@@ -523,7 +539,7 @@ public final class MethodBody {
             int b1 = Unsafe.getByte(oop, HDR.methodInfoStart-1) & 0xFF;
             return (((b0 << 8) | b1) >> 5) & 0x1F;
         } else {
-            return minfoValue(oop, 2);
+            return minfoU2Value(oop, HDR.methodInfoStart-3);
         }
     }
 
@@ -539,7 +555,7 @@ public final class MethodBody {
             int b1 = Unsafe.getByte(oop, HDR.methodInfoStart-1) & 0xFF;
             return b1 & 0x1F;
         } else {
-            return minfoValue(oop, 1);
+            return minfoU2Value(oop, HDR.methodInfoStart-1);
         }
     }
 
@@ -620,6 +636,21 @@ public final class MethodBody {
         return val;
     }
 
+    /**
+     * Decode a counter written with {@link #writeMinfoU2} at a fixed offset in a large minfo.
+     *
+     * @param oop the pointer to the method
+     * @param p the offset of the high byte of the counter
+     * @return the value
+     */
+    private static int minfoU2Value(Object oop, int p) {
+        Assert.that((Unsafe.getByte(oop, HDR.methodInfoStart) & FMT_LARGE) != 0);
+        int hi = Unsafe.getByte(oop, p) & 0xFF;
+        int lo = Unsafe.getByte(oop, p-1) & 0xFF;
+        Assert.that(hi > 127);
+        return ((hi & 0x7F) << 8) | lo;
+    }
+
     /**
      * Get the offset to the last byte of the Minfo area.
      *
@@ -18,15 +18,44 @@ import com.sun.squawk.util.*;
  *        u4 attributes;         // mask of the ATTRIBUTE_* constants in this class
  *        u4 parent_hash;
  *        utf8 parent_url;
+ *        u4 base_hash;          // only present if ATTRIBUTE_DELTA is set
+ *        utf8 base_url;         // only present if ATTRIBUTE_DELTA is set
  *        u4 root;               // offset (in bytes) in 'memory' of the root of the graph
  *        u4 size;               // size (in bytes) of memory
  *        u1 oopmap[((size / HDR.BYTES_PER_WORD) + 7) / 8];
  *        u1 padding[n];         // 0 <= n < HDR.BYTES_PER_WORD to align 'memory' on a word boundary
- *        u1 memory[size];
+ *        u1 memory[size];       // replaced by 'delta' if ATTRIBUTE_DELTA is set
  *        u1 typemap[size];      // only present if ATTRIBUTE_TYPEMAP is set
  *    }
  * </pre></blockquote><hr><p>
  *
+ * An object memory file with the ATTRIBUTE_DELTA attribute only records the ranges of
+ * 'memory' that differ from the 'memory' component of the file at 'base_url' (which may
+ * itself be a delta). There is no padding and 'memory' is replaced by:
+ *
+ * <p><hr><blockquote><pre>
+ *        u4 hash;               // hash of the reconstructed 'memory'
+ *        u4 ranges;
+ *        {
+ *            u4 offset;         // offset (in bytes) of the range in 'memory'
+ *            u4 length;
+ *            u1 bytes[length];
+ *        } delta[ranges];
+ * </pre></blockquote><hr><p>
+ *
+ * Any bytes of 'memory' not covered by a range are the same as in the base file.
+ * <p>
+ * In an object memory file with the ATTRIBUTE_COMPRESSED attribute the 'memory' component
+ * (unless it is replaced by a 'delta') and the 'typemap' component are each written as a
+ * sequence of blocks of up to {@link BlockCompressor#BLOCK_SIZE} bytes, each compressed
+ * by a {@link BlockCompressor}. There is no padding. A block is:
+ *
+ * <p><hr><blockquote><pre>
+ *        u4 length;             // length of 'data', or'ed with BLOCK_STORED if 'data' is not compressed
+ *        u4 checksum;           // Adler-32 checksum of the uncompressed block
+ *        u1 data[length];
+ * </pre></blockquote><hr><p>
+ *
  * @author Doug Simon
  */
 class ObjectMemoryLoader {
@@ -44,6 +73,22 @@ class ObjectMemoryLoader {
      */
     public static final int ATTRIBUTE_32BIT = 0x02;
 
+    /**
+     * Denotes a object memory file that only contains the differences between its 'memory'
+     * component and that of a base object memory file.
+     */
+    public static final int ATTRIBUTE_DELTA = 0x04;
+
+    /**
+     * Denotes a object memory file whose 'memory' and 'typemap' components are compressed.
+     */
+    public static final int ATTRIBUTE_COMPRESSED = 0x08;
+
+    /**
+     * The bit set in the length of a block in a compressed component if the block is stored uncompressed.
+     */
+    static final int BLOCK_STORED = 0x80000000;
+
     /**
      * An error thrown during relocation to indicate the buffer containing the pointers
      * being relocated has moved due to a garbage collection.
@@ -57,7 +102,7 @@ class ObjectMemoryLoader {
      * @param arr   the byte array to hash
      * @return      the hash of <code>arr</code>
      */
-    private static int hash(byte[] arr) {
+    static int hash(byte[] arr) {
         int hash = arr.length;
         for (int i = 0; i != arr.length; ++i) {
             hash += arr[i];
@@ -81,6 +126,11 @@ class ObjectMemoryLoader {
      */
     private final boolean loadIntoReadOnlyMemory;
 
+    /**
+     * Specifies if the object memory has the ATTRIBUTE_COMPRESSED attribute.
+     */
+    private boolean compressed;
+
     /**
      * Constructor.
      *
@@ -188,10 +238,23 @@ class ObjectMemoryLoader {
      */
     private void loadTypeMap(Address start, int size) {
         Address p = start;
-        for (int i = 0; i != size; ++i) {
-            byte type = (byte)reader.readByte(null);
-            Unsafe.setType(p, type, 1);
-            p = p.add(1);
+        if (compressed) {
+            byte[] block = new byte[BlockCompressor.BLOCK_SIZE];
+            byte[] scratch = new byte[BlockCompressor.MAX_COMPRESSED_SIZE];
+            for (int offset = 0; offset < size; offset += block.length) {
+                int length = Math.min(block.length, size - offset);
+                loadBlock(block, 0, length, scratch);
+                for (int i = 0; i != length; ++i) {
+                    Unsafe.setType(p, block[i], 1);
+                    p = p.add(1);
+                }
+            }
+        } else {
+            for (int i = 0; i != size; ++i) {
+                byte type = (byte)reader.readByte(null);
+                Unsafe.setType(p, type, 1);
+                p = p.add(1);
+            }
         }
         if (Klass.DEBUG && Tracer.isTracing("oms")) {
             Tracer.traceln("typemap:{size = " + size + "}");
@@ -208,6 +271,41 @@ class ObjectMemoryLoader {
             Tracer.traceln("Loading object memory from " + reader.getFileName());
         }
 
+        // Load the attributes
+        int attributes = loadAttributes();
+        boolean hasTypemap = (attributes & ATTRIBUTE_TYPEMAP) != 0;
+
+        // Load the parent of this object memory file
+        ObjectMemory parent = loadParent();
+
+        // Load the base of a delta object memory file
+        byte[] baseMemory = null;
+        if ((attributes & ATTRIBUTE_DELTA) != 0) {
+            Vector chain = new Vector();
+            chain.addElement(reader.getFileName());
+            baseMemory = loadBase(chain);
+        }
+
+        // Load the object memory file and relocate the object memory
+        ObjectMemory om = loadThis(parent, hasTypemap, baseMemory);
+
+        // Ensure there are no extra bytes at the end of the object memory file
+        reader.readEOF();
+
+        // Tracing
+        if (Klass.DEBUG && Tracer.isTracing("oms")) {
+            Tracer.traceln("Loaded object memory from " + reader.getFileName());
+        }
+
+        return om;
+    }
+
+    /**
+     * Loads the magic number, version numbers and attributes of an object memory from the input stream.
+     *
+     * @return the attributes of the object memory
+     */
+    protected int loadAttributes() {
         // Load magic
         int magic = reader.readInt("magic");
         if (magic != 0xdeadbeef) {
@@ -220,30 +318,159 @@ class ObjectMemoryLoader {
 
         // Load attributes
         int attributes = reader.readInt("attributes");
-        boolean hasTypemap = (attributes & ATTRIBUTE_TYPEMAP) != 0;
         boolean is32Bit = (attributes & ATTRIBUTE_32BIT) != 0;
+        compressed = (attributes & ATTRIBUTE_COMPRESSED) != 0;
 
         // Load the word size
         if (is32Bit != (HDR.BYTES_PER_WORD == 4)) {
             throw new LinkageError("invalid word size in object memory: expected " +
                                    (is32Bit ? "32 bit" : "64 bit") + ", received " + (is32Bit ? "64 bit" : "32 bit"));
         }
+        return attributes;
+    }
 
-        // Load the parent of this object memory file
-        ObjectMemory parent = loadParent();
+    /**
+     * Loads the 'memory' component of an object memory file in canonical form without
+     * relocating it. This is used to reconstruct the base image of a delta object memory file.
+     *
+     * @param url    the URL of the object memory file
+     * @param chain  the URLs of the delta object memory files already being reconstructed
+     * @return the contents of the 'memory' component
+     */
+    private static byte[] loadCanonicalMemory(String url, Vector chain) {
+        ObjectMemoryReader reader = null;
+        try {
+            try {
+                reader = new ObjectMemoryReader(Connector.openDataInputStream(url), url);
+            } catch (IOException ioe) {
+                throw new LinkageError("I/O error while trying to open " + url + ": " + ioe.toString());
+            }
+            ObjectMemoryLoader loader = new ObjectMemoryLoader(reader, false);
+            int attributes = loader.loadAttributes();
+            reader.readInt("parent_hash");
+            String parentURL = reader.readUTF("parent_url");
+            byte[] baseMemory = null;
+            if ((attributes & ATTRIBUTE_DELTA) != 0) {
+                baseMemory = loader.loadBase(chain);
+            }
+            reader.readInt("root");
+            int size = reader.readInt("size");
+            reader.skip(GC.calculateOopMapSizeInBytes(size), "oopmap");
+            return loader.loadMemoryComponent(null, parentURL, size, baseMemory);
+        } finally {
+            if (reader != null) {
+                reader.close();
+            }
+        }
+    }
 
-        // Load the object memory file and relocate the object memory
-        ObjectMemory om = loadThis(parent, hasTypemap);
+    /**
+     * Loads the base components of a delta object memory from the input stream and
+     * reconstructs the 'memory' component of the base image.
+     *
+     * @param chain  the URLs of the delta object memory files already being reconstructed
+     * @return the 'memory' component of the base image in canonical form
+     */
+    private byte[] loadBase(Vector chain) {
+        int baseHash = reader.readInt("base_hash");
+        String baseURL = reader.readUTF("base_url");
+        if (chain.contains(baseURL)) {
+            throw new LinkageError("cycle in the base chain of delta object memory " + reader.getFileName() + ": " + baseURL);
+        }
+        chain.addElement(baseURL);
+        byte[] baseMemory = loadCanonicalMemory(baseURL, chain);
+        if (hash(baseMemory) != baseHash) {
+            throw new LinkageError("invalid hash for base: expected " + baseHash + ", received " + hash(baseMemory));
+        }
+        return baseMemory;
+    }
 
-        // Ensure there are no extra bytes at the end of the object memory file
-        reader.readEOF();
+    /**
+     * Loads the 'delta' component of a delta object memory from the input stream and
+     * applies it to the 'memory' component of the base image.
+     *
+     * @param baseMemory  the 'memory' component of the base image
+     * @param size        the size of memory as specified by the 'size' element of the object memory
+     * @return the reconstructed 'memory' component
+     */
+    private byte[] loadDelta(byte[] baseMemory, int size) {
+        byte[] buffer = new byte[size];
+        System.arraycopy(baseMemory, 0, buffer, 0, Math.min(size, baseMemory.length));
+        int expectedHash = reader.readInt("hash");
+        int ranges = reader.readInt("ranges");
+        for (int i = 0; i != ranges; ++i) {
+            int offset = reader.readInt(null);
+            int length = reader.readInt(null);
+            if (offset < 0 || length < 0 || offset > size - length) {
+                throw reader.formatError("invalid delta range");
+            }
+            byte[] bytes = new byte[length];
+            reader.readFully(bytes, null);
+            System.arraycopy(bytes, 0, buffer, offset, length);
+        }
+        if (hash(buffer) != expectedHash) {
+            throw new LinkageError("invalid hash for delta object memory " + reader.getFileName() + ": expected " + expectedHash + ", received " + hash(buffer));
+        }
+        return buffer;
+    }
 
-        // Tracing
-        if (Klass.DEBUG && Tracer.isTracing("oms")) {
-            Tracer.traceln("Loaded object memory from " + reader.getFileName());
+    /**
+     * Loads the 'memory' component of an object memory, reconstructing it from a delta if necessary.
+     *
+     * @param parent      the loaded/resolved parent object memory
+     * @param parentURL   the value of the 'parent_url' item in the object memory file
+     * @param size        the size of memory as specified by the 'size' element of the object memory
+     * @param baseMemory  the 'memory' component of the base image if this is a delta object memory otherwise null
+     * @return the contents of the 'memory' component
+     */
+    private byte[] loadMemoryComponent(ObjectMemory parent, String parentURL, int size, byte[] baseMemory) {
+        if (baseMemory != null) {
+            return loadDelta(baseMemory, size);
+        }
+        if (compressed) {
+            byte[] buffer = new byte[size];
+            byte[] scratch = new byte[BlockCompressor.MAX_COMPRESSED_SIZE];
+            for (int offset = 0; offset < size; offset += BlockCompressor.BLOCK_SIZE) {
+                loadBlock(buffer, offset, Math.min(BlockCompressor.BLOCK_SIZE, size - offset), scratch);
+            }
+            if (Klass.DEBUG && Tracer.isTracing("oms")) {
+                Tracer.traceln("memory:{decompressed " + size + " bytes}");
+            }
+            return buffer;
         }
+        skipMemoryPadding(parentURL, size);
+        return loadMemory(parent, size);
+    }
 
-        return om;
+    /**
+     * Loads a block of a compressed component from the input stream and decompresses it.
+     *
+     * @param dst      the buffer into which the block is decompressed
+     * @param offset   the offset in <code>dst</code> of the block
+     * @param length   the expected length of the decompressed block
+     * @param scratch  a buffer of at least {@link BlockCompressor#MAX_COMPRESSED_SIZE} bytes
+     */
+    private void loadBlock(byte[] dst, int offset, int length, byte[] scratch) {
+        int header = reader.readInt(null);
+        int checksum = reader.readInt(null);
+        int dataLength = header & ~BLOCK_STORED;
+        if ((header & BLOCK_STORED) != 0) {
+            if (dataLength != length) {
+                throw reader.formatError("invalid stored block length");
+            }
+            reader.readFully(dst, offset, length, null);
+        } else {
+            if (dataLength > scratch.length) {
+                throw reader.formatError("invalid compressed block length");
+            }
+            reader.readFully(scratch, 0, dataLength, null);
+            if (!BlockCompressor.decompress(scratch, dataLength, dst, offset, length)) {
+                throw reader.formatError("malformed compressed block");
+            }
+        }
+        if (BlockCompressor.checksum(dst, offset, length) != checksum) {
+            throw reader.formatError("checksum mismatch in compressed block");
+        }
     }
 
     /**
@@ -319,9 +546,11 @@ class ObjectMemoryLoader {
     /**
      * Loads the non-parent components of an object memory from the input stream.
      *
-     * @param parent     the parent object memory
+     * @param parent      the parent object memory
+     * @param hasTypemap  specifies if the object memory has a type map
+     * @param baseMemory  the 'memory' component of the base image if this is a delta object memory otherwise null
      */
-    private ObjectMemory loadThis(ObjectMemory parent, boolean hasTypemap) {
+    private ObjectMemory loadThis(ObjectMemory parent, boolean hasTypemap, byte[] baseMemory) {
 
         String url = reader.getFileName();
 
@@ -334,11 +563,8 @@ class ObjectMemoryLoader {
         // Load the oop map
         BitSet oopMap = loadOopMap(size);
 
-        // Skip the padding
-        skipMemoryPadding(parent == null ? "" : parent.getURL(), size);
-
         // Load the object memory
-        byte[] buffer = loadMemory(parent, size);
+        byte[] buffer = loadMemoryComponent(parent, parent == null ? "" : parent.getURL(), size, baseMemory);
 
         // Calculate the hash of the object memory while it is in canonical form
         int hash = hash(buffer);
@@ -41,6 +41,72 @@ class ObjectMemorySerializer {
         public int root;
     }
 
+    /**
+     * The size (in bytes) of the blocks of 'memory' that are compared when writing a delta.
+     */
+    static final int DELTA_BLOCK_SIZE = 64;
+
+    /**
+     * A digest of the 'memory' component of a saved object memory. It holds a 64 bit hash
+     * of every {@link #DELTA_BLOCK_SIZE} byte block of the component, which is enough to
+     * write a delta against the component without keeping a copy of it.
+     */
+    static final class MemoryDigest {
+        /**
+         * The size of the 'memory' component.
+         */
+        final int size;
+
+        /**
+         * The hash of the 'memory' component as computed by {@link ObjectMemoryLoader#hash}.
+         */
+        final int hash;
+
+        /**
+         * The hashes of the blocks of the 'memory' component.
+         */
+        final long[] blocks;
+
+        /**
+         * Creates the digest of a serialized object graph.
+         *
+         * @param memory  the serialized object graph
+         * @param size    the size of the serialized object graph
+         */
+        MemoryDigest(Object memory, int size) {
+            this.size = size;
+            blocks = new long[(size + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE];
+            int hash = size;
+            for (int b = 0; b != blocks.length; ++b) {
+                int offset = b * DELTA_BLOCK_SIZE;
+                int end = Math.min(offset + DELTA_BLOCK_SIZE, size);
+                long h = 0xcbf29ce484222325L;
+                for (int i = offset; i != end; ++i) {
+                    byte value = (byte)Unsafe.getAsByte(memory, i);
+                    hash += value;
+                    h = (h ^ (value & 0xFF)) * 0x100000001b3L;
+                }
+                blocks[b] = h;
+            }
+            this.hash = hash;
+        }
+
+        /**
+         * Determines if a block differs from the block at the same offset in another digest.
+         *
+         * @param b     the index of the block
+         * @param base  the other digest
+         * @return true if the blocks have different lengths or hashes
+         */
+        boolean differs(int b, MemoryDigest base) {
+            if (b >= base.blocks.length || blocks[b] != base.blocks[b]) {
+                return true;
+            }
+            int offset = b * DELTA_BLOCK_SIZE;
+            return Math.min(DELTA_BLOCK_SIZE, size - offset) != Math.min(DELTA_BLOCK_SIZE, base.size - offset);
+        }
+    }
+
 
     /*---------------------------------------------------------------------------*\
      *                                  Saving                                   *
@@ -55,7 +121,28 @@ class ObjectMemorySerializer {
      * @throws IOException     if there is an IO error
      */
     public static void save(final String url, final ControlBlock cb, final ObjectMemory parent) throws IOException {
+        save(url, cb, parent, null, null, null, false);
+    }
+
+    /**
+     * Write a serialized object graph to a given URL. If a base image is given then only
+     * the blocks of the serialized graph that differ from the base image are written. The
+     * resulting file can only be loaded while the file containing the base image is
+     * still available.
+     *
+     * @param    url         where to write the serialized graph
+     * @param    cb          the control block describing the serialized object graph
+     * @param    parent      the object memory to which the serialized object memory is bound
+     * @param    baseURL     the URL of the base image or null if the complete graph is to be written
+     * @param    baseDigest  the digest of the 'memory' component of the base image in canonical form
+     * @param    digest      the digest of the serialized object graph. Only required if <code>baseURL</code> is not null
+     * @param    compress    specifies if the 'memory' and 'typemap' components are to be compressed
+     * @throws IOException     if there is an IO error
+     */
+    public static void save(final String url, final ControlBlock cb, final ObjectMemory parent, String baseURL, MemoryDigest baseDigest, MemoryDigest digest, boolean compress) throws IOException {
         Assert.that(parent != null  || VM.isHosted());
+        Assert.that((baseURL == null) == (baseDigest == null));
+        Assert.that(baseURL == null || digest != null);
         ObjectMemoryOutputStream sfos = new ObjectMemoryOutputStream(Connector.openDataOutputStream(url));
 
         // Tracing
@@ -78,6 +165,12 @@ class ObjectMemorySerializer {
         if (!Klass.SQUAWK_64) {
             attributes |= ObjectMemoryLoader.ATTRIBUTE_32BIT;
         }
+        if (baseURL != null) {
+            attributes |= ObjectMemoryLoader.ATTRIBUTE_DELTA;
+        }
+        if (compress) {
+            attributes |= ObjectMemoryLoader.ATTRIBUTE_COMPRESSED;
+        }
         sfos.writeInt(attributes, "attributes");
 
         if (parent == null) {
@@ -88,6 +181,11 @@ class ObjectMemorySerializer {
             sfos.writeUTF(parent.getURL(), "parent_url");
         }
 
+        if (baseURL != null) {
+            sfos.writeInt(baseDigest.hash, "base_hash");
+            sfos.writeUTF(baseURL, "base_url");
+        }
+
         final int size = cb.size;
         sfos.writeInt(cb.root, "root");
         sfos.writeInt(cb.size, "size");
@@ -110,23 +208,44 @@ class ObjectMemorySerializer {
             Tracer.traceln("oopmap:{cardinality = " + cb.oopMap.cardinality() + "}");
         }
 
-        // Write the padding to ensure 'memory' is word aligned
-        int pad = ObjectMemoryLoader.calculateMemoryPadding(parent == null ? "" : parent.getURL(), size);
-        while (pad-- != 0) {
-            sfos.writeByte(0);
-        }
+        if (baseURL != null) {
+            // Write the differences from the base image
+            writeDelta(sfos, cb.memory, digest, baseDigest);
+        } else if (compress) {
+            // Write the object memory as compressed blocks
+            BlockCompressor compressor = new BlockCompressor();
+            byte[] block = new byte[BlockCompressor.BLOCK_SIZE];
+            byte[] compressed = new byte[BlockCompressor.MAX_COMPRESSED_SIZE];
+            int written = 0;
+            for (int offset = 0; offset < size; offset += block.length) {
+                int length = Math.min(block.length, size - offset);
+                for (int i = 0; i != length; ++i) {
+                    block[i] = (byte)Unsafe.getAsByte(cb.memory, offset + i);
+                }
+                written += writeBlock(sfos, compressor, block, length, compressed);
+            }
+            if (Klass.DEBUG && Tracer.isTracing("oms")) {
+                Tracer.traceln("memory:{wrote " + size + " bytes compressed to " + written + " bytes}");
+            }
+        } else {
+            // Write the padding to ensure 'memory' is word aligned
+            int pad = ObjectMemoryLoader.calculateMemoryPadding(parent == null ? "" : parent.getURL(), size);
+            while (pad-- != 0) {
+                sfos.writeByte(0);
+            }
 
-        // Write the object memory itself.
-        for (int i = 0; i != size; ++i) {
-            sfos.writeByte(Unsafe.getAsByte(cb.memory, i));
-        }
-        if (Klass.DEBUG && Tracer.isTracing("oms")) {
-            Tracer.traceln("memory:{wrote " + size + " bytes}");
+            // Write the object memory itself.
+            for (int i = 0; i != size; ++i) {
+                sfos.writeByte(Unsafe.getAsByte(cb.memory, i));
+            }
+            if (Klass.DEBUG && Tracer.isTracing("oms")) {
+                Tracer.traceln("memory:{wrote " + size + " bytes}");
+            }
         }
 
 /*if[TYPEMAP]*/
         if (VM.usingTypeMap()) {
-            writeTypeMap(sfos, Address.fromObject(cb.memory), size);
+            writeTypeMap(sfos, Address.fromObject(cb.memory), size, compress);
         }
 /*end[TYPEMAP]*/
 
@@ -138,6 +257,76 @@ class ObjectMemorySerializer {
         }
     }
 
+    /**
+     * Writes a block in the compressed format described by {@link ObjectMemoryLoader}. The
+     * block is stored uncompressed if compressing it does not make it smaller.
+     *
+     * @param sfos        where to write the block
+     * @param compressor  the compressor
+     * @param block       the block
+     * @param length      the number of bytes in the block
+     * @param compressed  a buffer of at least {@link BlockCompressor#MAX_COMPRESSED_SIZE} bytes
+     * @return the number of bytes written
+     */
+    private static int writeBlock(ObjectMemoryOutputStream sfos, BlockCompressor compressor, byte[] block, int length, byte[] compressed) throws IOException {
+        int compressedLength = compressor.compress(block, length, compressed);
+        int checksum = BlockCompressor.checksum(block, 0, length);
+        if (compressedLength < length) {
+            sfos.writeInt(compressedLength, null);
+            sfos.writeInt(checksum, null);
+            sfos.write(compressed, 0, compressedLength);
+            return compressedLength + 8;
+        } else {
+            sfos.writeInt(length | ObjectMemoryLoader.BLOCK_STORED, null);
+            sfos.writeInt(checksum, null);
+            sfos.write(block, 0, length);
+            return length + 8;
+        }
+    }
+
+    /**
+     * Writes the blocks of a serialized object graph that differ from a base image.
+     * Consecutive changed blocks are written as one range.
+     *
+     * @param sfos        where to write the ranges
+     * @param memory      the serialized object graph
+     * @param digest      the digest of the serialized object graph
+     * @param baseDigest  the digest of the 'memory' component of the base image
+     */
+    private static void writeDelta(ObjectMemoryOutputStream sfos, Object memory, MemoryDigest digest, MemoryDigest baseDigest) throws IOException {
+        int blocks = digest.blocks.length;
+        int ranges = 0;
+        for (int b = 0; b != blocks; ++b) {
+            if (digest.differs(b, baseDigest) && (b == 0 || !digest.differs(b - 1, baseDigest))) {
+                ++ranges;
+            }
+        }
+        sfos.writeInt(digest.hash, "hash");
+        sfos.writeInt(ranges, "ranges");
+
+        int written = 0;
+        for (int b = 0; b != blocks; ) {
+            if (!digest.differs(b, baseDigest)) {
+                ++b;
+                continue;
+            }
+            int start = b * DELTA_BLOCK_SIZE;
+            while (b != blocks && digest.differs(b, baseDigest)) {
+                ++b;
+            }
+            int end = Math.min(b * DELTA_BLOCK_SIZE, digest.size);
+            sfos.writeInt(start, null);
+            sfos.writeInt(end - start, null);
+            for (int i = start; i != end; ++i) {
+                sfos.writeByte(Unsafe.getAsByte(memory, i));
+            }
+            written += end - start;
+        }
+        if (Klass.DEBUG && Tracer.isTracing("oms")) {
+            Tracer.traceln("memory:{wrote " + written + " of " + digest.size + " bytes in " + ranges + " ranges}");
+        }
+    }
+
 /*if[TYPEMAP]*/
     /**
      * Writes the type map describing the type of every address in an object memory.
@@ -145,13 +334,28 @@ class ObjectMemorySerializer {
      * @param sfos    where to write the map
      * @param start   the start address of the object memory
      * @param size    the size address of the object memory
+     * @param compress  specifies if the map is to be written as compressed blocks
      */
-    private static void writeTypeMap(ObjectMemoryOutputStream sfos, Address start, int size) throws IOException {
+    private static void writeTypeMap(ObjectMemoryOutputStream sfos, Address start, int size, boolean compress) throws IOException {
         Address p = start;
-        for (int i = 0; i != size; ++i) {
-            byte type = Unsafe.getType(p);
-            sfos.writeByte(type);
-            p = p.add(1);
+        if (compress) {
+            BlockCompressor compressor = new BlockCompressor();
+            byte[] block = new byte[BlockCompressor.BLOCK_SIZE];
+            byte[] compressed = new byte[BlockCompressor.MAX_COMPRESSED_SIZE];
+            for (int offset = 0; offset < size; offset += block.length) {
+                int length = Math.min(block.length, size - offset);
+                for (int i = 0; i != length; ++i) {
+                    block[i] = Unsafe.getType(p);
+                    p = p.add(1);
+                }
+                writeBlock(sfos, compressor, block, length, compressed);
+            }
+        } else {
+            for (int i = 0; i != size; ++i) {
+                byte type = Unsafe.getType(p);
+                sfos.writeByte(type);
+                p = p.add(1);
+            }
         }
         if (Klass.DEBUG && Tracer.isTracing("oms")) {
             Tracer.traceln("typemap:{size = " + size + "}");
@@ -84,6 +84,11 @@ public final class ServiceOperation {
      */
     private static int result;
 
+    /**
+     * The high 32 bits of a 64 bit result (only set by operations that produce one).
+     */
+    private static int resultHigh;
+
     /**
      * The pending exception for the next catch bytecode.
      */
@@ -130,6 +135,17 @@ public final class ServiceOperation {
         }
     }
 
+    /**
+     * Get the high 32 bits of the result of the last operation that produced
+     * a 64 bit result. This must be read before another service operation is
+     * executed.
+     *
+     * @return the high 32 bits of the last 64 bit result
+     */
+    static int getResultHigh() {
+        return resultHigh;
+    }
+
     /**
      * Execute a channel I/O operation.
      */
@@ -441,12 +441,25 @@ public final class Suite {
      *         some other IO problem while writing the file.
      */
     public String save() throws java.io.IOException {
+        return save(false);
+    }
+
+    /**
+     * Serializes and saves to a file the object graph rooted by this suite.
+     * A compressed suite file cannot be used as the bootstrap suite.
+     *
+     * @param compress  specifies if the suite file is written in compressed form
+     * @return the URL to which the suite was saved
+     * @throws IOException if there was insufficient memory to do the save or there was
+     *         some other IO problem while writing the file.
+     */
+    public String save(boolean compress) throws java.io.IOException {
         ObjectMemorySerializer.ControlBlock cb = VM.copyObjectGraph(this);
         if (cb == null) {
             throw new java.io.IOException("insufficient memory for object graph copying");
         }
         String url = "file://" + name + ".suite";
-        ObjectMemorySerializer.save(url, cb, GC.lookupObjectMemoryByRoot(parent));
+        ObjectMemorySerializer.save(url, cb, GC.lookupObjectMemoryByRoot(parent), null, null, null, compress);
         return url;
     }
 
@@ -37,6 +37,11 @@ public class SuiteCreator {
      */
     private boolean retainLVTs;
 
+    /**
+     * Determines if the suite file is to be written in compressed form.
+     */
+    private boolean compress;
+
     /**
      * Prints the usage message.
      *
@@ -59,6 +64,7 @@ public class SuiteCreator {
         out.println("                          for private fields and methods");
         out.println("    -lnt            retain line number tables");
         out.println("    -lvt            retain local variable tables");
+        out.println("    -compress       write the suite file in compressed form");
         out.println("    -help           show this help message and exit");
         out.println();
         out.println("Note: If no prefixes are specified, then all the classes found on the");
@@ -142,7 +148,7 @@ public class SuiteCreator {
         }
 
         openSuite.close(suiteType, retainLNTs, retainLVTs);
-        String fileName = openSuite.save();
+        String fileName = openSuite.save(compress);
         System.out.println("Created suite and wrote it into " + fileName);
         System.exit(0);
     }
@@ -183,6 +189,8 @@ public class SuiteCreator {
                 retainLNTs = true;
             } else if (arg.equals("-lvt")) {
                 retainLVTs = true;
+            } else if (arg.equals("-compress")) {
+                compress = true;
             } else if (arg.startsWith("-h")) {
                 usage(null);
                 return false;
@@ -78,6 +78,11 @@ public class Test {
         x44();
         x45();
 //        x46();
+        x47();
+        x48();
+        x49();
+        x50();
+        x51();
         randomTimeTest();
         VM.print("Finished tests\n");
         System.exit(12345);
@@ -459,6 +464,149 @@ public class Test {
         result("x46", true);
     }
 
+    /*
+     * The tests of the translator's optimization passes only exercise them
+     * when the suite containing this class is built with -opt.
+     */
+
+    static class X47 {
+        int value;
+        X47(int value) {
+            this.value = value;
+        }
+        final int getValue() {
+            return value;
+        }
+        private int twice() {
+            return value * 2;
+        }
+        int sum() {
+            return getValue() + twice();
+        }
+    }
+
+    static void x47() {
+        boolean ok = new X47(7).sum() == 21;
+        X47 x = null;
+        try {
+            x.getValue();
+            ok = false;
+        } catch (NullPointerException e) {
+        }
+        result("x47", ok);
+    }
+
+    static void x48() {
+        int[] a = new int[10];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i;
+        }
+        int sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i];
+        }
+        boolean ok = sum == 45;
+        try {
+            for (int i = 0; i <= a.length; i++) {
+                sum += a[i];
+            }
+            ok = false;
+        } catch (ArrayIndexOutOfBoundsException e) {
+        }
+        result("x48", ok);
+    }
+
+    static class X49 {
+        int x;
+        int y;
+        X49(int x, int y) {
+            this.x = x;
+            this.y = y;
+        }
+    }
+
+    static void x49() {
+        X49 p = new X49(3, 4);
+        p.x = p.x * p.x;
+        synchronized (p) {
+            p.y = p.y * p.y;
+        }
+        result("x49", p.x + p.y == 25);
+    }
+
+    /**
+     * Tests the primitive array operations of com.sun.squawk.util.Arrays.
+     */
+    static void x50() {
+        int[] ints = { 5, -3, 9, 0, Integer.MIN_VALUE, 9, 1, -3, 7, 2, 8, 6, 4, 3, 100, -50, 11, 12, 13, Integer.MAX_VALUE };
+        com.sun.squawk.util.Arrays.sort(ints);
+        boolean ok = true;
+        for (int i = 1; i < ints.length; i++) {
+            ok = ok && ints[i - 1] <= ints[i];
+        }
+        ok = ok && ints[0] == Integer.MIN_VALUE && ints[ints.length - 1] == Integer.MAX_VALUE;
+        ok = ok && com.sun.squawk.util.Arrays.binarySearch(ints, 100) == ints.length - 2;
+        ok = ok && com.sun.squawk.util.Arrays.binarySearch(ints, 10) == -(15 + 1);
+
+        long[] longs = { 3L, 1L << 40, 2L, -1L << 40, 0L };
+        com.sun.squawk.util.Arrays.sort(longs, 1, 4);
+        ok = ok && longs[0] == 3L && longs[1] == -1L << 40 && longs[2] == 2L && longs[3] == 1L << 40 && longs[4] == 0L;
+
+        byte[] bytes = { 10, -128, 127, 0, -1, 10 };
+        com.sun.squawk.util.Arrays.sort(bytes);
+        ok = ok && bytes[0] == -128 && bytes[1] == -1 && bytes[2] == 0 && bytes[3] == 10 && bytes[4] == 10 && bytes[5] == 127;
+
+        char[] chars = { 'c', '\uffff', 'a', 'b' };
+        com.sun.squawk.util.Arrays.sort(chars);
+        ok = ok && chars[0] == 'a' && chars[3] == '\uffff';
+        ok = ok && com.sun.squawk.util.Arrays.binarySearch(chars, 'b') == 1;
+
+        short[] shorts = new short[5];
+        com.sun.squawk.util.Arrays.fill(shorts, 1, 4, (short)-2);
+        ok = ok && shorts[0] == 0 && shorts[1] == -2 && shorts[3] == -2 && shorts[4] == 0;
+
+        boolean[] bools1 = new boolean[3];
+        boolean[] bools2 = new boolean[3];
+        com.sun.squawk.util.Arrays.fill(bools1, true);
+        ok = ok && !com.sun.squawk.util.Arrays.equals(bools1, bools2);
+        com.sun.squawk.util.Arrays.fill(bools2, true);
+        ok = ok && com.sun.squawk.util.Arrays.equals(bools1, bools2);
+        ok = ok && com.sun.squawk.util.Arrays.equals(new int[] { 1, 2 }, new int[] { 1, 2 });
+        ok = ok && !com.sun.squawk.util.Arrays.equals(new long[] { 1L, 2L }, new long[] { 1L, 3L });
+        result("x50", ok);
+    }
+
+    /*
+     * The constants used by x51 come from small methods so that they are only
+     * known after inlining.
+     */
+
+    static int x51three() {
+        return 3;
+    }
+
+    static long x51big() {
+        return 1L << 40;
+    }
+
+    static int x51quotient;
+    static void x51() {
+        boolean ok = (x51three() * 4 + 1 == 13) &&
+                     (x51three() << 30 == -1073741824) &&
+                     (-x51three() >>> 28 == 15) &&
+                     ((byte)(x51three() * 100) == 44) &&
+                     (x51big() + x51three() == 1099511627779L) &&
+                     ((int)(x51big() - 1) == -1) &&
+                     (x51big() > x51three()) &&
+                     !(x51big() < 0L);
+        try {
+            x51quotient = x51three() / (x51three() - 3);
+            ok = false;
+        } catch (ArithmeticException e) {
+        }
+        result("x51", ok);
+    }
+
     static void randomTimeTest() {
         long iterations = System.currentTimeMillis() & 255;
         iterations = iterations*iterations*iterations;
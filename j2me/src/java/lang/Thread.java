@@ -650,10 +650,17 @@ public class Thread implements Runnable {
     boolean isDaemon;
 
     /**
-     * Reference used for enqueueing in the timer queue.
+     * Reference used for enqueueing in the timer queue's list of pending
+     * threads and in the list of an isolate's hibernated timer threads.
      */
     Thread nextTimerThread;
 
+    /**
+     * The position of the thread in the timer queue's heap, or
+     * TimerQueue.PENDING if it is in the timer queue's list of pending threads.
+     */
+    int timerIndex;
+
     /**
      * Threads waiting for this thread to die.
      */
@@ -927,6 +934,11 @@ public class Thread implements Runnable {
          */
         while (true) {
 
+            /*
+             * Sample the clock once for this pass over the timer queue.
+             */
+            long now = System.currentTimeMillis();
+
             /*
              * Add any threads that are ready to be restarted.
              */
@@ -941,7 +953,7 @@ public class Thread implements Runnable {
             /*
              * Add any threads waiting for a certain time that are now due.
              */
-            while ((thread = timerQueue.next()) != null) {
+            while ((thread = timerQueue.next(now)) != null) {
                 Assert.that(thread.isAlive());
                 Monitor monitor = thread.monitor;
                 /*
@@ -974,7 +986,7 @@ public class Thread implements Runnable {
             /*
              * Wait for an event or until timeout.
              */
-            long delta = timerQueue.nextDelta();
+            long delta = timerQueue.nextDelta(now);
             if (delta > 0) {
                 if (delta == Long.MAX_VALUE && events.size() == 0) {
                     /*
@@ -1560,9 +1572,20 @@ final class Monitor {
 final class ThreadQueue {
 
     /**
-     * The first thread in the queue.
+     * The first thread in the queue for each priority level.
+     */
+    private final Thread[] firsts = new Thread[Thread.MAX_PRIORITY + 1];
+
+    /**
+     * The last thread in the queue for each priority level.
+     */
+    private final Thread[] lasts = new Thread[Thread.MAX_PRIORITY + 1];
+
+    /**
+     * The set of priority levels whose queue is not empty. Bit 'p' is set if
+     * there is a thread in the queue of priority level 'p'.
      */
-    Thread first;
+    private int levels;
 
     /**
      * The count of threads in the queue.
@@ -1570,29 +1593,25 @@ final class ThreadQueue {
     int count;
 
     /**
-     * Add a thread to the queue.
+     * Add a thread to the queue. The thread is placed behind all the threads
+     * of the same priority already in the queue.
      *
      * @param thread the thread to add
      */
     void add(Thread thread) {
         Assert.that(thread.isAlive());
+        Assert.that(thread.nextThread == null);
         thread.setInQueue(Thread.RUN);
         count++;
-        if (first == null) {
-            first = thread;
+        int priority = thread.priority;
+        Thread last = lasts[priority];
+        if (last == null) {
+            firsts[priority] = thread;
+            levels |= 1 << priority;
         } else {
-            if (first.priority < thread.priority) {
-                thread.nextThread = first;
-                first = thread;
-            } else {
-                Thread last = first;
-                while (last.nextThread != null && last.nextThread.priority >= thread.priority) {
-                    last = last.nextThread;
-                }
-                thread.nextThread = last.nextThread;
-                last.nextThread = thread;
-            }
+            last.nextThread = thread;
         }
+        lasts[priority] = thread;
     }
 
     /**
@@ -1605,18 +1624,30 @@ final class ThreadQueue {
     }
 
     /**
-     * Get the next thread in the queue.
+     * Get the next thread in the queue. This is the first thread in the
+     * queue of the highest non-empty priority level.
      *
      * @return a thread or null if there is none
      */
     Thread next() {
-        Thread thread = first;
-        if (thread != null) {
-            thread.setNotInQueue(Thread.RUN);
-            first = thread.nextThread;
-            thread.nextThread = null;
-            count--;
+        int levels = this.levels;
+        if (levels == 0) {
+            return null;
+        }
+        int priority = Thread.MAX_PRIORITY;
+        while ((levels & (1 << priority)) == 0) {
+            priority--;
         }
+        Thread thread = firsts[priority];
+        thread.setNotInQueue(Thread.RUN);
+        Thread next = thread.nextThread;
+        firsts[priority] = next;
+        if (next == null) {
+            lasts[priority] = null;
+            this.levels = levels & ~(1 << priority);
+        }
+        thread.nextThread = null;
+        count--;
         return thread;
     }
 
@@ -1627,19 +1658,23 @@ final class ThreadQueue {
      * @param isolate  the isolate whose runnable threads are to be removed
      */
     void prune(Isolate isolate) {
-        Thread oldQueue = first;
-        count = 0;
-        first = null;
-        while(oldQueue != null) {
-            Thread thread = oldQueue;
-            oldQueue = oldQueue.nextThread;
-            thread.nextThread = null;
-            thread.setNotInQueue(Thread.RUN);
-            if (thread.getIsolate() != isolate) {
-                add(thread);
-            } else {
-                thread.setInQueue(Thread.HIBERNATEDRUN);
-                isolate.addToHibernatedRunThread(thread);
+        for (int priority = Thread.MAX_PRIORITY; priority >= Thread.MIN_PRIORITY; priority--) {
+            Thread oldQueue = firsts[priority];
+            firsts[priority] = null;
+            lasts[priority] = null;
+            levels &= ~(1 << priority);
+            while (oldQueue != null) {
+                Thread thread = oldQueue;
+                oldQueue = oldQueue.nextThread;
+                thread.nextThread = null;
+                thread.setNotInQueue(Thread.RUN);
+                count--;
+                if (thread.getIsolate() != isolate) {
+                    add(thread);
+                } else {
+                    thread.setInQueue(Thread.HIBERNATEDRUN);
+                    isolate.addToHibernatedRunThread(thread);
+                }
             }
         }
     }
@@ -1653,57 +1688,168 @@ final class ThreadQueue {
 final class TimerQueue {
 
     /**
-     * The first thread in the queue.
+     * The value of Thread.timerIndex for a thread in the list of pending threads.
+     */
+    final static int PENDING = -1;
+
+    /**
+     * The initial capacity of the heap.
+     */
+    private final static int INITIAL_CAPACITY = 16;
+
+    /**
+     * The binary heap of threads ordered by the time at which they are due.
+     * The heap is 1-based: heap[1] is the thread due first and the children of
+     * heap[i] are heap[2*i] and heap[2*i+1]. Each thread in the heap records its
+     * position in Thread.timerIndex so that it can be removed in O(log n) time.
+     */
+    private Thread[] heap = new Thread[INITIAL_CAPACITY];
+
+    /**
+     * The number of threads in the heap.
      */
-    Thread first;
+    private int size;
 
     /**
-     * Add a thread to the queue.
+     * The threads that have been added since the clock was last sampled. The
+     * 'time' field of these threads holds their delay relative to the time at
+     * which they are admitted to the heap. This list is linked by
+     * Thread.nextTimerThread.
+     */
+    private Thread pending;
+
+    /**
+     * Add a thread to the queue. The absolute time at which the thread is due is
+     * only computed the next time the clock is sampled by {@link #next(long)}.
+     * As a thread is always added to the queue just before the scheduler runs,
+     * this is the time at which the thread was added.
      *
      * @param thread the thread to add
      * @param delta the time period
      */
     void add(Thread thread, long delta) {
-        Assert.that(thread.nextTimerThread == null);
-        thread.time = System.currentTimeMillis() + delta;
-        if (thread.time < 0) {
-
-           /*
-            * If delta is so huge that the time went negative then just make
-            * it a very large value. The universe will end before the error
-            * can be detected.
-            */
-            thread.time = Long.MAX_VALUE;
+        Assert.that(thread.nextTimerThread == null && thread.timerIndex == 0);
+        Assert.that(delta > 0);
+        thread.time = delta;
+        thread.timerIndex = PENDING;
+        thread.nextTimerThread = pending;
+        pending = thread;
+    }
+
+    /**
+     * Move the pending threads to the heap.
+     *
+     * @param now the current time
+     */
+    private void admit(long now) {
+        while (pending != null) {
+            Thread thread = pending;
+            pending = thread.nextTimerThread;
+            thread.nextTimerThread = null;
+            thread.time += now;
+            if (thread.time < 0) {
+
+               /*
+                * If delta is so huge that the time went negative then just make
+                * it a very large value. The universe will end before the error
+                * can be detected.
+                */
+                thread.time = Long.MAX_VALUE;
+            }
+            if (size + 1 == heap.length) {
+                Thread[] newHeap = new Thread[heap.length * 2];
+                System.arraycopy(heap, 0, newHeap, 0, heap.length);
+                heap = newHeap;
+            }
+            size++;
+            siftUp(thread, size);
         }
-        if (first == null) {
-            first = thread;
-        } else {
-            if (first.time > thread.time) {
-                thread.nextTimerThread = first;
-                first = thread;
+    }
+
+    /**
+     * Place a thread at a given position in the heap.
+     *
+     * @param thread the thread
+     * @param i      the position
+     */
+    private void place(Thread thread, int i) {
+        heap[i] = thread;
+        thread.timerIndex = i;
+    }
+
+    /**
+     * Move a thread towards the root of the heap until its parent is due no later than it.
+     *
+     * @param thread the thread
+     * @param i      the position of the hole the thread is to fill
+     */
+    private void siftUp(Thread thread, int i) {
+        while (i > 1) {
+            Thread parent = heap[i >> 1];
+            if (parent.time <= thread.time) {
+                break;
+            }
+            place(parent, i);
+            i >>= 1;
+        }
+        place(thread, i);
+    }
+
+    /**
+     * Move a thread towards the leaves of the heap until its children are due no earlier than it.
+     *
+     * @param thread the thread
+     * @param i      the position of the hole the thread is to fill
+     */
+    private void siftDown(Thread thread, int i) {
+        int half = size >> 1;
+        while (i <= half) {
+            int child = i << 1;
+            if (child < size && heap[child + 1].time < heap[child].time) {
+                child++;
+            }
+            if (thread.time <= heap[child].time) {
+                break;
+            }
+            place(heap[child], i);
+            i = child;
+        }
+        place(thread, i);
+    }
+
+    /**
+     * Remove the thread at a given position in the heap.
+     *
+     * @param i the position
+     */
+    private void removeAt(int i) {
+        Thread thread = heap[i];
+        Thread last = heap[size];
+        heap[size] = null;
+        size--;
+        if (last != thread) {
+            if (i > 1 && last.time < heap[i >> 1].time) {
+                siftUp(last, i);
             } else {
-                Thread last = first;
-                while (last.nextTimerThread != null && last.nextTimerThread.time < thread.time) {
-                    last = last.nextTimerThread;
-                }
-                thread.nextTimerThread = last.nextTimerThread;
-                last.nextTimerThread = thread;
+                siftDown(last, i);
             }
         }
+        thread.timerIndex = 0;
     }
 
     /**
      * Get the next thread in the queue that has reached its time.
      *
+     * @param now the current time
      * @return a thread or null if there is none
      */
-    Thread next() {
-        Thread thread = first;
-        if (thread == null || thread.time > System.currentTimeMillis()) {
+    Thread next(long now) {
+        admit(now);
+        if (size == 0 || heap[1].time > now) {
             return null;
         }
-        first = first.nextTimerThread;
-        thread.nextTimerThread = null;
+        Thread thread = heap[1];
+        removeAt(1);
         Assert.that(thread.time != 0);
         thread.time = 0;
         return thread;
@@ -1715,44 +1861,51 @@ final class TimerQueue {
      * @param thread the thread
      */
     void remove(Thread thread) {
-        if (first == null) {
-            Assert.that(thread.time == 0);
-            return;
-        }
         if (thread.time == 0) {
+            Assert.that(thread.timerIndex == 0);
             return;
         }
         thread.time = 0;
-        if (thread == first) {
-            first = thread.nextTimerThread;
-            thread.nextTimerThread = null;
-            return;
-        }
-        Thread p = first;
-        while (p.nextTimerThread != null) {
-            if (p.nextTimerThread == thread) {
-                p.nextTimerThread = thread.nextTimerThread;
+        int i = thread.timerIndex;
+        if (i == PENDING) {
+            thread.timerIndex = 0;
+            if (pending == thread) {
+                pending = thread.nextTimerThread;
                 thread.nextTimerThread = null;
                 return;
             }
-            p = p.nextTimerThread;
+            Thread p = pending;
+            while (p.nextTimerThread != null) {
+                if (p.nextTimerThread == thread) {
+                    p.nextTimerThread = thread.nextTimerThread;
+                    thread.nextTimerThread = null;
+                    return;
+                }
+                p = p.nextTimerThread;
+            }
+            VM.fatalVMError();
         }
-        VM.fatalVMError();
+        if (i <= 0 || i > size || heap[i] != thread) {
+            VM.fatalVMError();
+        }
+        removeAt(i);
     }
 
     /**
      * Get the time delta to the next event in the queue.
      *
+     * @param now the current time
      * @return the time
      */
-    long nextDelta() {
+    long nextDelta(long now) {
         boolean isTckTest = VM.getCurrentIsolate().isTckTest();
-        if (first != null) {
-            long now = System.currentTimeMillis();
-            if (now >= first.time) {
+        admit(now);
+        if (size != 0) {
+            long time = heap[1].time;
+            if (now >= time) {
                 return 0;
             }
-            long res = first.time - now;
+            long res = time - now;
             if (isTckTest && res > (1000*60)) {
                 VM.print("Long wait in TCK ");
                 VM.print(res);
@@ -1773,20 +1926,25 @@ final class TimerQueue {
      * @param isolate  the isolate whose timer-blocked threads are to be removed
      */
     void prune(Isolate isolate) {
-        start:
-        while (true) {
-            Thread t = first;
-            while (t != null) {
-                if (t.getIsolate() == isolate) {
-                    long time = t.time - System.currentTimeMillis();
-                    remove(t);
-                    t.time = time;
-                    isolate.addToHibernatedTimerThread(t);
-                    continue start;
-                }
-                t = t.nextTimerThread;
+        long now = System.currentTimeMillis();
+        admit(now);
+        int i = 1;
+        while (i <= size) {
+            Thread t = heap[i];
+            if (t.getIsolate() == isolate) {
+                long time = t.time - now;
+                remove(t);
+                t.time = (time <= 0) ? 1 : time;
+                isolate.addToHibernatedTimerThread(t);
+
+                /*
+                 * Removing the thread may have moved a thread already
+                 * examined so restart the scan.
+                 */
+                i = 1;
+            } else {
+                i++;
             }
-            break;
         }
     }
 
@@ -618,6 +618,11 @@ public class VM {
      * Throw an exception. This routine will search for the exception handler for the
      * exception being thrown, reset the return ip and fp of the activation record that
      * it was called with and then 'return' to the handler in question.
+     * <p>
+     * The interpreter first searches for the handler itself and only switches to
+     * the service thread to call this routine when the handler is not found in an
+     * activation on the stack of the throwing thread or when exception handling
+     * has not yet been enabled.
      */
     static void throwException(Throwable exception) {
         Object otherStack = Thread.getOtherThreadStack();
@@ -1130,6 +1135,28 @@ public class VM {
         executeCIO(-1, ChannelConstants.INTERNAL_PRINTSTRING, -1, 0, 0, 0, 0, 0, 0, str, null);
     }
 
+    /**
+     * Prints a range of bytes to the VM stream.
+     *
+     * @param b       the bytes to print
+     * @param off     the offset of the first byte to print
+     * @param len     the number of bytes to print
+     */
+    static void printBytes(byte[] b, int off, int len) {
+        Assert.that(off >= 0 && len >= 0 && off + len <= b.length);
+        executeCIO(-1, ChannelConstants.INTERNAL_PRINTBYTES, -1, off, len, 0, 0, 0, 0, b, null);
+    }
+
+    /**
+     * Forces any output buffered for a VM stream to be written.
+     *
+     * @param stream  the stream to flush (one of the STREAM_... constants)
+     */
+    static void flushStream(int stream) {
+        Assert.always(stream >= STREAM_STDOUT && stream <= STREAM_SYMBOLS, "invalid stream specifier");
+        execIO(ChannelConstants.INTERNAL_FLUSHSTREAM, stream);
+    }
+
     /**
      * Prints an address to the VM stream. This will be formatted as an unsigned 32 bit or 64 bit
      * value depending on the underlying platform.
@@ -1197,6 +1224,7 @@ public class VM {
     public static void print(int x)        { printInt(x); }
     public static void print(long x)       { printLong(x); }
     public static void print(boolean b)    { print(b ? "true" : "false"); }
+    public static void print(byte[] b, int off, int len) { printBytes(b, off, len); }
 
     public static void println(char x)     { printChar(x); println(); }
     public static void println(String x)   { printString(x); println(); }
@@ -1206,6 +1234,8 @@ public class VM {
 
     public static void println()           { print("\n"); }
 
+    public static void flush(int stream)   { flushStream(stream); }
+
 
     /*-----------------------------------------------------------------------*\
      *                        Miscellaneous functions                        *
@@ -1456,8 +1486,8 @@ public class VM {
      * @return the time in milliseconds
      */
     static long getTime() {
-        long high = execIO(ChannelConstants.INTERNAL_GETTIME_HIGH, 0); // Must get high word first.
-        long low  = execIO(ChannelConstants.INTERNAL_GETTIME_LOW, 0);
+        long low  = execIO(ChannelConstants.INTERNAL_GETTIME, 0);
+        long high = ServiceOperation.getResultHigh();
         return (high << 32) | (low & 0x00000000FFFFFFFFL);
     }
 
@@ -1551,6 +1581,23 @@ public class VM {
         execIO(ChannelConstants.INTERNAL_STOPVM, code);
     }
 
+    /**
+     * Waits for a launch request if the VM was started as a zygote (i.e. with the
+     * -Xzygote native option). The zygote forks a child process for each request
+     * and so this method only returns in a child.
+     *
+     * @return the command line arguments of the launch request or null if the VM is not a zygote
+     */
+    static String[] awaitLaunchRequest() {
+        int count = execIO(ChannelConstants.INTERNAL_ZYGOTE, 0);
+        if (count < 0) {
+            return null;
+        }
+        String[] args = new String[count];
+        GC.copyCStringArray(argv, args);
+        return args;
+    }
+
     /**
      * Copy memory from one array to another.
      *
@@ -30,7 +30,11 @@ import com.sun.squawk.io.j2se.*;
 import com.sun.squawk.io.*;
 
 /**
- * "zip://file.zip/path/filename.ext"
+ * "zip://file.zip@path/filename.ext"
+ * <p>
+ * A name ending with "/" opens a listing of the entries in that directory of
+ * the zip file ("//" for a recursive listing). An empty entry name opens a
+ * stream containing the modification time of the zip file as a long.
  *
  * @author  Nik Shaylor
  * @version 1.0 10/08/99
@@ -41,12 +45,105 @@ public class Protocol extends ConnectionBase implements StreamConnection {
     /** InputStream object */
     InputStream is;
 
-    /** Zip file handle */
-    ZipFile  z;
-
     /** Open count */
     int opens = 0;
 
+    /**
+     * The zip files opened so far, keyed by name. A zip file is kept open so
+     * that its central directory is only read once. The values are
+     * ZipFile instances.
+     */
+    private static Hashtable zipFiles = new Hashtable();
+
+    /**
+     * The modification times of the files in {@link #zipFiles} when they were
+     * opened. The values are Long instances.
+     */
+    private static Hashtable zipFileTimes = new Hashtable();
+
+    /**
+     * The number of connections using each zip file that has a connection using
+     * it. The keys are ZipFile instances and the values are Integer instances.
+     */
+    private static Hashtable zipFileUsers = new Hashtable();
+
+    /**
+     * The zip file used by this connection.
+     */
+    private ZipFile zipFile;
+
+    /**
+     * Gets the (shared) zip file for a given name and registers the caller as a
+     * user of it. A zip file that has been modified since it was last opened is
+     * reopened. The file it replaces is closed once it has no more users so that
+     * the streams still reading from it are not broken.
+     *
+     * @param zipName  the name of the zip file
+     * @return the zip file
+     */
+    private static synchronized ZipFile acquireZipFile(String zipName) throws IOException {
+        long time = new File(zipName).lastModified();
+        ZipFile zipFile = (ZipFile)zipFiles.get(zipName);
+        if (zipFile != null && ((Long)zipFileTimes.get(zipName)).longValue() != time) {
+            zipFiles.remove(zipName);
+            zipFileTimes.remove(zipName);
+            if (zipFileUsers.get(zipFile) == null) {
+                closeZipFile(zipFile);
+            }
+            zipFile = null;
+        }
+        if (zipFile == null) {
+            zipFile = new ZipFile(zipName);
+            zipFiles.put(zipName, zipFile);
+            zipFileTimes.put(zipName, new Long(time));
+        }
+        Integer users = (Integer)zipFileUsers.get(zipFile);
+        zipFileUsers.put(zipFile, new Integer(users == null ? 1 : users.intValue() + 1));
+        return zipFile;
+    }
+
+    /**
+     * Unregisters a user of a zip file obtained from {@link #acquireZipFile}. The zip
+     * file is closed if it has been replaced and this was its last user.
+     *
+     * @param zipFile  the zip file
+     */
+    private static synchronized void releaseZipFile(ZipFile zipFile) {
+        int users = ((Integer)zipFileUsers.get(zipFile)).intValue() - 1;
+        if (users != 0) {
+            zipFileUsers.put(zipFile, new Integer(users));
+        } else {
+            zipFileUsers.remove(zipFile);
+            if (zipFiles.get(zipFile.getName()) != zipFile) {
+                closeZipFile(zipFile);
+            }
+        }
+    }
+
+    /**
+     * Closes a zip file, ignoring any error.
+     *
+     * @param zipFile  the zip file
+     */
+    private static void closeZipFile(ZipFile zipFile) {
+        try {
+            zipFile.close();
+        } catch (IOException ex) {
+        }
+    }
+
+    /**
+     * Returns a stream containing the modification time of a zip file as a long.
+     * The time is 0 if the file does not exist.
+     */
+    private static InputStream getLastModifiedFor(String zipName) throws IOException {
+        ByteArrayOutputStream baos = new ByteArrayOutputStream();
+        DataOutputStream dos = new DataOutputStream(baos);
+        dos.writeLong(new File(zipName).lastModified());
+        dos.close();
+        return new ByteArrayInputStream(baos.toByteArray());
+    }
+
     /**
      * Open the connection
      */
@@ -80,14 +177,18 @@ public class Protocol extends ConnectionBase implements StreamConnection {
 
         if (mode == Connector.READ) {
             try {
-                if (name.endsWith("/")) {
+                if (filename.length() == 0) {
+                    is = getLastModifiedFor(zipname);
+                } else if (name.endsWith("/")) {
                     is = getListingFor(zipname, filename);
                 } else {
-                    z = new ZipFile(zipname);
-                    ZipEntry e = z.getEntry(filename);
+                    zipFile = acquireZipFile(zipname);
+                    ZipEntry e = zipFile.getEntry(filename);
                     if (e != null) {
-                        is = z.getInputStream(e);
+                        is = zipFile.getInputStream(e);
                     } else {
+                        releaseZipFile(zipFile);
+                        zipFile = null;
                         throw new ConnectionNotFoundException(name);
                     }
                 }
@@ -116,27 +217,22 @@ public class Protocol extends ConnectionBase implements StreamConnection {
             fileName = "";
         }
 
-        ZipFile zipFile = null;
         try {
-            zipFile = new ZipFile(zipName);
-
-            Enumeration e = zipFile.entries();
-            while (e.hasMoreElements()) {
-                ZipEntry zipEntry = (ZipEntry)e.nextElement();
-                String name = zipEntry.getName();
-                if (name.startsWith(fileName) && name.charAt(name.length() - 1) != '/' &&  (recursive || name.indexOf('/', fileName.length()) == -1)) {
-                    dos.writeUTF(name);
+            ZipFile z = acquireZipFile(zipName);
+            try {
+                Enumeration e = z.entries();
+                while (e.hasMoreElements()) {
+                    ZipEntry zipEntry = (ZipEntry)e.nextElement();
+                    String name = zipEntry.getName();
+                    if (name.startsWith(fileName) && name.charAt(name.length() - 1) != '/' &&  (recursive || name.indexOf('/', fileName.length()) == -1)) {
+                        dos.writeUTF(name);
+                    }
                 }
+            } finally {
+                releaseZipFile(z);
             }
         } catch (IOException ioe) {
             throw new ConnectionNotFoundException(zipName);
-        } finally {
-            if (zipFile != null) {
-                try {
-                    zipFile.close();
-                } catch (IOException ex) {
-                }
-            }
         }
 
         dos.close();
@@ -180,9 +276,10 @@ public class Protocol extends ConnectionBase implements StreamConnection {
     public void close() throws IOException {
         if (opens > 0) {
             opens--;
-            if (opens == 0 && z != null) {
-                z.close();
-            }
+        }
+        if (opens == 0 && zipFile != null) {
+            releaseZipFile(zipFile);
+            zipFile = null;
         }
     }
 
@@ -244,11 +244,11 @@ public class GenericConnectionChannel extends Channel {
                     return getEventNumber();
                 }
                 int    off = i1;
-                int    len = Math.min(i2, dis.available());
+                int    len = Math.min(i2, Math.max(1, dis.available())); // read at least one byte so that a buffer refill never returns 0
                 byte[] buf = (byte[])o2;
                 result = dis.read(buf, off, len);
                 if (inLog != null) {
-                    for (int i = off; i < off + len; i++) {
+                    for (int i = off; i < off + result; i++) {
                         inLog.writeByte(buf[i]);
                     }
                 }
@@ -16,6 +16,9 @@ import com.sun.squawk.vm.*;
 import com.sun.squawk.util.*;
 import com.sun.squawk.translator.*;
 import com.sun.squawk.translator.ir.InstructionEmitter;
+import com.sun.squawk.translator.ir.IRPassManager;
+import com.sun.squawk.translator.ir.MethodReferences;
+import com.sun.squawk.translator.ci.ClassFileLoader;
 import com.sun.squawk.util.Vector;    // Version without synchronization
 import com.sun.squawk.util.Hashtable; // Version without synchronization
 
@@ -82,6 +85,17 @@ public class Romizer {
      */
     boolean retainLVTs;
 
+    /**
+     * The specifications of the classes whose methods are all entry points for the
+     * tree shaker or null if unreachable code is not to be removed.
+     */
+    Vector shakeRoots;
+
+    /**
+     * The names of the optimization passes applied to the methods of the suite.
+     */
+    String enabledPasses = "";
+
 /*if[J2ME.STATS]*/
     /**
      * Print various stats.
@@ -117,6 +131,15 @@ public class Romizer {
         out.println("                                 for private fields and methods");
         out.println("    -lnt                retain line number tables");
         out.println("    -lvt                retain local variable tables");
+        out.println("    -opt[:<passes>]     optimize the IR of each method with the given passes");
+        out.println("                        separated by ',' (default=all). The passes are:");
+        out.println("                        " + IRPassManager.getPassNames());
+        out.println("    -fieldprofile:<file> lay out the instance fields of the classes in file");
+        out.println("                        according to their access counts. Each line of file");
+        out.println("                        is '<class>.<field> <count>'");
+        out.println("    -shake[:<file>]     remove the methods that are unreachable from the entry");
+        out.println("                        points. All the methods of the classes that match the");
+        out.println("                        class names or packages in file are entry points");
 /*if[J2ME.STATS]*/
         out.println("    -stats              print various stats.");
 /*end[J2ME.STATS]*/
@@ -131,10 +154,12 @@ public class Romizer {
         out.println("    -traceclassfile     trace low-level class file elements");
         out.println("    -traceimage         trace building of ROM image");
         out.println("    -traceir0           trace the IR built from the JVM bytecodes");
+        out.println("    -traceoptimizer     trace the IR after each optimization pass that changed it");
         out.println("    -traceir1           trace optimized IR with JVM bytcode offsets");
         out.println("    -traceir2           trace optimized IR with Squawk bytcode offsets");
         out.println("    -tracemethods       trace emitted Squawk bytecode methods");
         out.println("    -tracepruning       trace pruning of symbolic information");
+        out.println("    -traceshaking       trace the methods removed by -shake");
         out.println("    -traceoml           trace object memory deserialization");
         out.println("    -traceoms           trace object memory serialization");
         out.println("    -tracefilter:<string>  filter trace with simple string filter");
@@ -226,6 +251,65 @@ public class Romizer {
         return excludes;
     }
 
+    /**
+     * Processes a file with the instance field access counts used to lay out the
+     * fields of the classes being romized. Each line of the file is a fully
+     * qualified field name and an access count separated by a space. The classes
+     * whose field offsets are defined in com.sun.squawk.vm.FieldOffsets are
+     * omitted from the profile as their layout is known to the VM.
+     *
+     * @param file     the field profile
+     * @return a table mapping class names to tables mapping field names to counts
+     */
+    private Hashtable readFieldProfile(String file) {
+        Hashtable fixed = new Hashtable();
+        java.lang.reflect.Field[] offsets = com.sun.squawk.vm.FieldOffsets.class.getDeclaredFields();
+        for (int i = 0; i != offsets.length; ++i) {
+            String name = offsets[i].getName();
+            int indexOf$ = name.indexOf('$');
+            if (indexOf$ != -1) {
+                String className = name.substring(0, indexOf$).replace('_', '.');
+                if (className.equals("java.lang.Klass")) {
+                    className = "java.lang.Class";
+                }
+                fixed.put(className, className);
+            }
+        }
+
+        Vector lines = new Vector();
+        ArgsUtilities.readLines(file, lines);
+        Hashtable profile = new Hashtable();
+        for (Enumeration e = lines.elements(); e.hasMoreElements(); ) {
+            String line = ((String)e.nextElement()).trim();
+            if (line.length() == 0 || line.charAt(0) == '#') {
+                continue;
+            }
+            int space = line.indexOf(' ');
+            int dot = line.lastIndexOf('.', space == -1 ? line.length() : space);
+            if (space == -1 || dot == -1) {
+                usage("invalid line in field profile " + file + ": " + line);
+                throw new RuntimeException();
+            }
+            String className = line.substring(0, dot);
+            String fieldName = line.substring(dot + 1, space);
+            Integer count = Integer.valueOf(line.substring(space + 1).trim());
+            if (className.equals("java.lang.Klass")) {
+                className = "java.lang.Class";
+            }
+            if (fixed.get(className) != null) {
+                System.out.println("warning: ignoring profile for " + className + " whose field offsets are known to the VM");
+                continue;
+            }
+            Hashtable fields = (Hashtable)profile.get(className);
+            if (fields == null) {
+                fields = new Hashtable();
+                profile.put(className, fields);
+            }
+            fields.put(fieldName, count);
+        }
+        return profile;
+    }
+
     /**
      * Commmand line interface.
      *
@@ -458,6 +542,24 @@ public class Romizer {
                 retainLNTs = true;
             } else if (arg.equals("-lvt")) {
                 retainLVTs = true;
+            } else if (arg.equals("-opt")) {
+                enabledPasses = "all";
+            } else if (arg.startsWith("-opt:")) {
+                try {
+                    enabledPasses = arg.substring("-opt:".length());
+                    new IRPassManager(enabledPasses);
+                } catch (IllegalArgumentException e) {
+                    usage(e.getMessage());
+                    throw new RuntimeException();
+                }
+            } else if (arg.startsWith("-fieldprofile:")) {
+                ClassFileLoader.setFieldProfile(readFieldProfile(arg.substring("-fieldprofile:".length())));
+            } else if (arg.equals("-shake")) {
+                shakeRoots = new Vector();
+                MethodReferences.enable();
+            } else if (arg.startsWith("-shake:")) {
+                shakeRoots = readExcludesFile(arg.substring("-shake:".length()));
+                MethodReferences.enable();
 /*if[J2ME.STATS]*/
             } else if (arg.equals("-stats")) {
                 stats = true;
@@ -600,7 +702,9 @@ public class Romizer {
         Isolate isolate = new Isolate(null, null, suite);
         VM.setCurrentIsolate(isolate);
 
-        isolate.setTranslator(new Translator());
+        Translator t = new Translator();
+        t.setEnabledPasses(enabledPasses);
+        isolate.setTranslator(t);
         TranslatorInterface translator = isolate.getTranslator();
 
         /*
@@ -670,6 +774,14 @@ public class Romizer {
          * Save the bootstrap suite.
          */
         Suite bootstrapSuite = VM.getCurrentIsolate().getBootstrapSuite();
+
+        /*
+         * Remove the unreachable code.
+         */
+        if (shakeRoots != null) {
+            new TreeShaker(bootstrapSuite, suiteType, shakeRoots).shake();
+        }
+
         bootstrapSuite.updateConfiguration(suiteType, retainLNTs, retainLVTs);
         String url = bootstrapSuite.save();
         generatedFiles.addElement(new File(prefix + ".suite").getAbsolutePath());
@@ -0,0 +1,534 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM.
+ */
+package java.lang;
+
+import java.util.Enumeration;
+import com.sun.squawk.vm.*;
+import com.sun.squawk.util.*;
+import com.sun.squawk.translator.Translator;
+import com.sun.squawk.translator.ir.MethodReferences;
+import com.sun.squawk.util.Vector;    // Version without synchronization
+import com.sun.squawk.util.Hashtable; // Version without synchronization
+
+/**
+ * The tree shaker removes the code that can never be executed from a translated
+ * suite before it is saved. The methods reachable from a set of entry points
+ * are computed from the {@link MethodReferences references} recorded by the
+ * translator for each method body. The entry points are:
+ * <ul>
+ * <li>the <code>do_*</code> methods in <code>java.lang.VM</code> called by the VM</li>
+ * <li>every <code>main(String[])</code> method</li>
+ * <li><code>Runnable.run()</code> of every instantiable implementation</li>
+ * <li>every method of the classes listed in the roots file. Classes that are only
+ *     ever loaded reflectively by name must be listed here</li>
+ * <li>unless the suite is an application suite, every method that can be linked
+ *     to by another suite (i.e. the methods whose symbols are retained when the
+ *     suite is closed with the same suite type)</li>
+ * </ul>
+ * A class is instantiable once it is referenced by reachable code. Its class
+ * initializer and default constructor are then reachable and virtual and interface
+ * invocations are resolved against its vtable.
+ * <p>
+ * The class numbers and the instance field, static field and vtable layouts are
+ * baked into the translated bytecode and so classes and fields are never removed.
+ * Instead, each unreachable method body is replaced by a stub that throws an
+ * exception and the entries in the object table of a class (i.e. its string and
+ * class constants) that are only used by unreachable methods are cleared.
+ */
+final class TreeShaker {
+
+    /**
+     * A virtual or interface invocation.
+     */
+    private static final class CallSite {
+        final Klass klass;
+        final int offset;
+        final boolean isInterface;
+
+        CallSite(Klass klass, int offset, boolean isInterface) {
+            this.klass = klass;
+            this.offset = offset;
+            this.isInterface = isInterface;
+        }
+    }
+
+    /**
+     * The suite being shaken.
+     */
+    private final Suite suite;
+
+    /**
+     * The type the suite will be closed with.
+     */
+    private final int suiteType;
+
+    /**
+     * The class names or package prefixes (ending with '*') of the classes whose methods are all entry points.
+     */
+    private final Vector roots;
+
+    /**
+     * The reachable method bodies.
+     */
+    private final Hashtable reachable = new Hashtable();
+
+    /**
+     * The reachable method bodies that have not yet been scanned.
+     */
+    private final Vector worklist = new Vector();
+
+    /**
+     * The instantiable classes.
+     */
+    private final Hashtable liveClasses = new Hashtable();
+
+    /**
+     * The classes in {@link #liveClasses} in the order they became live.
+     */
+    private final Vector liveClassList = new Vector();
+
+    /**
+     * The virtual and interface invocations made by the reachable code.
+     */
+    private final Vector callSites = new Vector();
+
+    /**
+     * The keys of the call sites in {@link #callSites}.
+     */
+    private final Hashtable callSiteKeys = new Hashtable();
+
+    /**
+     * The classes with a reachable method for which no references were recorded.
+     */
+    private final Hashtable unscannedClasses = new Hashtable();
+
+    /**
+     * Creates a tree shaker for a suite.
+     *
+     * @param suite      the translated suite
+     * @param suiteType  the type the suite will be closed with
+     * @param roots      the specifications of the classes whose methods are all entry points
+     */
+    TreeShaker(Suite suite, int suiteType, Vector roots) {
+        this.suite = suite;
+        this.suiteType = suiteType;
+        this.roots = roots;
+    }
+
+    /**
+     * Removes the unreachable code from the suite.
+     */
+    void shake() {
+        addRoots();
+        while (!worklist.isEmpty()) {
+            MethodBody body = (MethodBody)worklist.lastElement();
+            worklist.removeElementAt(worklist.size() - 1);
+            scan(body);
+        }
+        prune();
+    }
+
+    /*---------------------------------------------------------------------------*\
+     *                               Reachability                                *
+    \*---------------------------------------------------------------------------*/
+
+    /**
+     * Marks the entry points as reachable.
+     */
+    private void addRoots() {
+        Klass vm = suite.lookup("java.lang.VM");
+        int count = vm.getMethodCount(true);
+        for (int i = 0; i != count; ++i) {
+            Method method = vm.getMethod(i, true);
+            if (method.isVMdoMethod()) {
+                markBody(vm.getStaticMethods()[method.getOffset()]);
+            }
+        }
+
+        int classCount = suite.getClassCount();
+        for (int cno = 0; cno != classCount; ++cno) {
+            Klass klass = suite.getKlass(cno);
+            if (klass == null || klass.isArray() || klass.isSynthetic()) {
+                continue;
+            }
+            boolean isRoot = isRootClass(klass);
+            if (isRoot || (suiteType != Suite.APPLICATION && isExported(klass))) {
+                markClass(klass);
+            }
+            for (int j = 0; j != 2; ++j) {
+                boolean isStatic = j == 0;
+                Object[] methods = isStatic ? klass.getStaticMethods() : klass.getVirtualMethods();
+                if (methods == null || (!isStatic && klass.isInterface())) {
+                    continue;
+                }
+                int methodCount = klass.getMethodCount(isStatic);
+                for (int i = 0; i != methodCount; ++i) {
+                    Method method = klass.getMethod(i, isStatic);
+                    if (isRoot || isMain(method) || (suiteType != Suite.APPLICATION && isExported(klass, method))) {
+                        markBody(methods[method.getOffset()]);
+                    }
+                }
+            }
+        }
+
+        Klass runnable = suite.lookup("java.lang.Runnable");
+        if (runnable != null) {
+            int methodCount = runnable.getMethodCount(false);
+            for (int i = 0; i != methodCount; ++i) {
+                Method method = runnable.getMethod(i, false);
+                if (method.getName().equals("run")) {
+                    addCallSite(method, true);
+                }
+            }
+        }
+    }
+
+    /**
+     * Determines if a class is listed in the roots file.
+     *
+     * @param klass  the class
+     * @return true if all the methods of <code>klass</code> are entry points
+     */
+    private boolean isRootClass(Klass klass) {
+        String name = klass.getInternalName();
+        for (Enumeration e = roots.elements(); e.hasMoreElements(); ) {
+            String spec = (String)e.nextElement();
+            if (spec.endsWith("*") ? name.startsWith(spec.substring(0, spec.length() - 1)) : name.equals(spec)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Determines if a method is a <code>main(String[])</code> method.
+     *
+     * @param method  the method
+     * @return true if <code>method</code> can be invoked by the VM to start an application
+     */
+    private static boolean isMain(Method method) {
+        if (method.isStatic() && method.getName().equals("main") && method.getReturnType() == Klass.VOID) {
+            Klass[] types = method.getParameterTypes();
+            return types.length == 1 && types[0] == Klass.STRING_ARRAY;
+        }
+        return false;
+    }
+
+    /**
+     * Determines if a class can be linked to by another suite.
+     *
+     * @param klass  the class
+     * @return true if the symbols of <code>klass</code> are retained when the suite is closed
+     */
+    private boolean isExported(Klass klass) {
+        return suiteType != Suite.LIBRARY || klass.isPublic();
+    }
+
+    /**
+     * Determines if a method can be linked to by another suite.
+     *
+     * @param klass   the class declaring the method
+     * @param method  the method
+     * @return true if the symbols of <code>method</code> are retained when the suite is closed
+     */
+    private boolean isExported(Klass klass, Method method) {
+        if (!isExported(klass) || method.isPrivate()) {
+            return false;
+        }
+        return suiteType != Suite.LIBRARY || method.isPublic() || method.isProtected();
+    }
+
+    /**
+     * Marks a method body as reachable.
+     *
+     * @param entry  an entry in a method table
+     */
+    private void markBody(Object entry) {
+        if (entry instanceof MethodBody && reachable.get(entry) == null) {
+            MethodBody body = (MethodBody)entry;
+            reachable.put(body, body);
+            worklist.addElement(body);
+            markClass(body.getDefiningClass());
+        }
+    }
+
+    /**
+     * Marks a class (and its super classes) as instantiable.
+     *
+     * @param klass  the class
+     */
+    private void markClass(Klass klass) {
+        if (klass == null || liveClasses.get(klass) != null) {
+            return;
+        }
+        liveClasses.put(klass, klass);
+        liveClassList.addElement(klass);
+        markClass(klass.getSuperclass());
+
+        /*
+         * The class initializer and default constructor may be invoked by the VM
+         */
+        Object[] methods = klass.getStaticMethods();
+        int count = methods == null ? 0 : klass.getMethodCount(true);
+        for (int i = 0; i != count; ++i) {
+            Method method = klass.getMethod(i, true);
+            if (method.isClassInitializer() || (method.isConstructor() && method.getParameterTypes().length == 0)) {
+                markBody(methods[method.getOffset()]);
+            }
+        }
+
+        for (Enumeration e = callSites.elements(); e.hasMoreElements(); ) {
+            resolve((CallSite)e.nextElement(), klass);
+        }
+    }
+
+    /**
+     * Records a virtual or interface invocation and marks its targets in the
+     * instantiable classes as reachable.
+     *
+     * @param method       the invoked method
+     * @param isInterface  true if <code>method</code> is invoked via its interface
+     */
+    private void addCallSite(Method method, boolean isInterface) {
+        Klass klass = method.getDefiningClass();
+        isInterface &= klass.isInterface();
+        String key = klass.getInternalName() + (isInterface ? "#i" : "#v") + method.getOffset();
+        if (callSiteKeys.get(key) == null) {
+            callSiteKeys.put(key, key);
+            CallSite site = new CallSite(klass, method.getOffset(), isInterface);
+            callSites.addElement(site);
+            for (int i = 0; i != liveClassList.size(); ++i) {
+                resolve(site, (Klass)liveClassList.elementAt(i));
+            }
+        }
+    }
+
+    /**
+     * Marks the target of an invocation in an instantiable class as reachable.
+     *
+     * @param site   the invocation
+     * @param klass  an instantiable class
+     */
+    private void resolve(CallSite site, Klass klass) {
+        if (klass.isInterface() || klass.isAbstract() || !site.klass.isAssignableFrom(klass)) {
+            return;
+        }
+        Object[] vtable = klass.getVirtualMethods();
+        int offset = site.isInterface ? klass.findSlot(site.klass, site.offset) : site.offset;
+        if (vtable != null && offset < vtable.length) {
+            markBody(vtable[offset]);
+        }
+    }
+
+    /**
+     * Marks the methods invoked and the classes referenced by a reachable method body.
+     *
+     * @param body  the method body
+     */
+    private void scan(MethodBody body) {
+        MethodReferences references = MethodReferences.get(body);
+        if (references == null) {
+            Klass klass = body.getDefiningClass();
+            if (unscannedClasses.get(klass) == null) {
+                unscannedClasses.put(klass, klass);
+                System.out.println("warning: no references recorded for methods in " + klass + " (the code they reach may be removed)");
+            }
+            return;
+        }
+
+        Klass[] classes = references.getReferencedClasses();
+        for (int i = 0; i != classes.length; ++i) {
+            markClass(classes[i]);
+        }
+
+        int count = references.getInvocationCount();
+        for (int i = 0; i != count; ++i) {
+            Method method = references.getInvokedMethod(i);
+            Klass klass = method.getDefiningClass();
+            switch (references.getInvocationKind(i)) {
+                case MethodReferences.STATIC: {
+                    markBody(klass.getStaticMethods()[method.getOffset()]);
+                    break;
+                }
+                case MethodReferences.SUPER: {
+                    markBody(klass.getVirtualMethods()[method.getOffset()]);
+                    break;
+                }
+                case MethodReferences.VIRTUAL: {
+                    addCallSite(method, false);
+                    break;
+                }
+                case MethodReferences.INTERFACE: {
+                    addCallSite(method, true);
+                    break;
+                }
+                default: {
+                    throw Assert.shouldNotReachHere();
+                }
+            }
+        }
+    }
+
+    /*---------------------------------------------------------------------------*\
+     *                                  Pruning                                  *
+    \*---------------------------------------------------------------------------*/
+
+    /**
+     * Replaces the unreachable method bodies with stubs and clears the unused object table entries.
+     */
+    private void prune() {
+        Hashtable stubs = new Hashtable();
+        int methodCount = 0;
+        int classCount = suite.getClassCount();
+        for (int cno = 0; cno != classCount; ++cno) {
+            Klass klass = suite.getKlass(cno);
+            if (klass == null || klass.isArray() || klass.isSynthetic()) {
+                continue;
+            }
+            methodCount += pruneMethods(klass, true, stubs);
+            methodCount += pruneMethods(klass, false, stubs);
+        }
+
+        /*
+         * Update the inherited entries in the vtables of the subclasses
+         */
+        for (int cno = 0; cno != classCount; ++cno) {
+            Klass klass = suite.getKlass(cno);
+            Object[] vtable = klass == null ? null : klass.getVirtualMethods();
+            if (vtable != null) {
+                for (int i = 0; i != vtable.length; ++i) {
+                    Object stub = vtable[i] == null ? null : stubs.get(vtable[i]);
+                    if (stub != null) {
+                        vtable[i] = stub;
+                    }
+                }
+            }
+        }
+
+        int objectCount = 0;
+        for (int cno = 0; cno != classCount; ++cno) {
+            Klass klass = suite.getKlass(cno);
+            if (klass != null && !klass.isArray() && !klass.isSynthetic() && unscannedClasses.get(klass) == null) {
+                objectCount += pruneObjectTable(klass);
+            }
+        }
+
+        System.out.println("[tree shaking removed " + stubs.size() + " of " + (methodCount + reachable.size()) +
+                           " methods and " + objectCount + " constants from " + suite + "]");
+    }
+
+    /**
+     * Replaces the unreachable method bodies defined by a class with stubs.
+     *
+     * @param klass     the class
+     * @param isStatic  specifies whether the static or virtual methods are pruned
+     * @param stubs     the table mapping each replaced method body to its stub
+     * @return the number of methods replaced
+     */
+    private int pruneMethods(Klass klass, boolean isStatic, Hashtable stubs) {
+        Object[] methods = isStatic ? klass.getStaticMethods() : klass.getVirtualMethods();
+        if (methods == null) {
+            return 0;
+        }
+        int count = 0;
+        for (int i = 0; i != methods.length; ++i) {
+            Object entry = methods[i];
+            if (entry instanceof MethodBody && reachable.get(entry) == null && stubs.get(entry) == null) {
+                MethodBody body = (MethodBody)entry;
+                if (body.getDefiningClass() == klass) {
+                    MethodBody stub = createStub(body);
+                    klass.installMethodBody(stub, isStatic);
+                    stubs.put(body, stub);
+                    count++;
+
+                    if (Klass.DEBUG && Tracer.isTracing("shaking")) {
+                        Tracer.traceln("[removed " + body.getDefiningMethod() + "]");
+                    }
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Creates the stub for an unreachable method body. The stub throws a
+     * <code>NullPointerException</code> if it is ever invoked.
+     *
+     * @param body  the unreachable method body
+     * @return the stub
+     */
+    private static MethodBody createStub(MethodBody body) {
+        byte[] code = { (byte)OPC.EXTEND0, (byte)OPC.CONST_NULL, (byte)OPC.THROW };
+/*if[TYPEMAP]*/
+        byte[] typeMap = null;
+        if (VM.usingTypeMap()) {
+            typeMap = new byte[code.length];
+            typeMap[0] = (byte)((AddressType.UNDEFINED << AddressType.MUTATION_TYPE_SHIFT) | AddressType.BYTECODE);
+            typeMap[1] = (byte)((AddressType.REF       << AddressType.MUTATION_TYPE_SHIFT) | AddressType.BYTECODE);
+            typeMap[2] = (byte)((AddressType.UNDEFINED << AddressType.MUTATION_TYPE_SHIFT) | AddressType.BYTECODE);
+        }
+/*end[TYPEMAP]*/
+        return new MethodBody(
+                               body.getDefiningMethod(),
+                               body.getIndex(),
+                               1,
+                               new Klass[0],
+                               null,
+                               null,
+/*if[SCOPEDLOCALVARIABLES]*/
+                               null,
+/*end[SCOPEDLOCALVARIABLES]*/
+                               code,
+/*if[TYPEMAP]*/
+                               typeMap,
+/*end[TYPEMAP]*/
+                               Translator.REVERSE_PARAMETERS
+                             );
+    }
+
+    /**
+     * Clears the entries in the object table of a class that are not used by any of its reachable methods.
+     *
+     * @param klass  the class
+     * @return the number of entries cleared
+     */
+    private int pruneObjectTable(Klass klass) {
+        Object[] objects = klass.getObjectTable();
+        if (objects == null || objects.length == 0) {
+            return 0;
+        }
+        boolean[] used = new boolean[objects.length];
+        boolean anyUsed = false;
+        for (int j = 0; j != 2; ++j) {
+            Object[] methods = j == 0 ? klass.getStaticMethods() : klass.getVirtualMethods();
+            for (int i = 0; methods != null && i != methods.length; ++i) {
+                Object entry = methods[i];
+                if (entry instanceof MethodBody && reachable.get(entry) != null && ((MethodBody)entry).getDefiningClass() == klass) {
+                    int[] indexes = MethodReferences.get((MethodBody)entry).getObjectIndexes();
+                    for (int k = 0; k != indexes.length; ++k) {
+                        used[indexes[k]] = true;
+                        anyUsed = true;
+                    }
+                }
+            }
+        }
+
+        int count = 0;
+        for (int i = 0; i != objects.length; ++i) {
+            if (!used[i] && objects[i] != null) {
+                objects[i] = null;
+                count++;
+            }
+        }
+        if (!anyUsed) {
+            klass.setObjectTable(new Object[0]);
+        }
+        return count;
+    }
+}
@@ -0,0 +1,91 @@
+package hibernation;
+
+import javax.microedition.io.*;
+import java.io.*;
+
+/**
+ * Tests that the deltas written by incremental saves of an isolate stay small
+ * while the isolate only updates objects it already has, and that the isolate
+ * can be loaded from the last delta in the chain.
+ */
+public class Test2 {
+
+    static final int RUNS = 5;
+
+    public static void main(String[] args) throws java.io.IOException {
+        String cp = Thread.currentThread().getIsolate().getClassPath();
+        Isolate isolate = new Isolate("hibernation.Counter", new String[] { "" + RUNS }, cp, null);
+
+        isolate.start();
+        isolate.join();
+
+        int fullSize = 0;
+        String url = null;
+        for (int i = 0; isolate.isHibernated(); ++i) {
+            url = "file://incremental" + i + ".isolate";
+            isolate.save(url, true);
+            int size = sizeOf(url);
+            if (i == 0) {
+                fullSize = size;
+            } else {
+                System.out.println("delta " + i + ": " + size + " bytes (complete image: " + fullSize + " bytes)");
+                check("delta " + i + " is not small", size * 4 < fullSize);
+            }
+            isolate.unhibernate();
+            isolate.join();
+        }
+        check("counter failed", isolate.getExitCode() == 0);
+
+        isolate = Isolate.load(url);
+        isolate.unhibernate();
+        isolate.join();
+        check("counter loaded from " + url + " failed", isolate.getExitCode() == 0);
+
+        System.out.println("Test2 passed");
+        System.exit(0);
+    }
+
+    static int sizeOf(String url) throws java.io.IOException {
+        InputStream in = Connector.openInputStream(url);
+        byte[] buf = new byte[1024];
+        int size = 0;
+        int n;
+        while ((n = in.read(buf)) != -1) {
+            size += n;
+        }
+        in.close();
+        return size;
+    }
+
+    static void check(String what, boolean b) {
+        if (!b) {
+            System.out.println("Test2 failed: " + what);
+            System.exit(1);
+        }
+    }
+}
+
+/**
+ * Hibernates a given number of times, updating an existing array in between
+ * but allocating nothing that is kept.
+ */
+class Counter {
+
+    public static void main(String[] args) throws java.io.IOException {
+        int runs = Integer.parseInt(args[0]);
+        int[] counts = new int[64];
+        Isolate thisIsolate = Thread.currentThread().getIsolate();
+        for (int run = 0; run != runs; ++run) {
+            for (int i = 0; i != counts.length; ++i) {
+                counts[i] += i;
+            }
+            thisIsolate.hibernate();
+        }
+        for (int i = 0; i != counts.length; ++i) {
+            if (counts[i] != i * runs) {
+                System.exit(1);
+            }
+        }
+        System.exit(0);
+    }
+}
@@ -0,0 +1,177 @@
+package tests;
+
+import java.io.*;
+import javax.microedition.io.*;
+
+/**
+ * Tests that a GET request pipelined behind a response whose large body is
+ * abandoned gets its own response and not the rest of the abandoned body.
+ * <p>
+ * The test runs its own HTTP/1.1 server on a local port. The server only sends
+ * the first part of the large body until it has received the pipelined request,
+ * so that the large body is abandoned while the pipelined request is queued on
+ * the same connection. The thread sending the pipelined request runs at a lower
+ * priority than the thread abandoning the large body to make that order likely.
+ * The result must be the same if the large body is read into memory first.
+ */
+public class HttpPipelining {
+
+    static final int PORT = 9998;
+    static final int BIG = 64 * 1024;
+    static final String SMALL = "small body";
+
+    /**
+     * Set by the server once it has received a request pipelined behind "/big".
+     */
+    static boolean pipelined;
+
+    static String result;
+
+    public static void main(String[] args) throws Exception {
+        final StreamConnectionNotifier server = (StreamConnectionNotifier)Connector.open("serversocket://:" + PORT);
+        new Thread() {
+            public void run() {
+                try {
+                    for (;;) {
+                        final StreamConnection con = server.acceptAndOpen();
+                        new Thread() {
+                            public void run() {
+                                serve(con);
+                            }
+                        }.start();
+                    }
+                } catch (IOException ioe) {
+                }
+            }
+        }.start();
+
+        Thread.currentThread().setPriority(Thread.MAX_PRIORITY);
+
+        HttpConnection big = (HttpConnection)Connector.open("http://localhost:" + PORT + "/big");
+        check("big response code", big.getResponseCode() == 200);
+
+        Thread client = new Thread() {
+            public void run() {
+                try {
+                    HttpConnection small = (HttpConnection)Connector.open("http://localhost:" + PORT + "/small");
+                    InputStream in = small.openInputStream();
+                    ByteArrayOutputStream buf = new ByteArrayOutputStream();
+                    int ch;
+                    while ((ch = in.read()) != -1) {
+                        buf.write(ch);
+                    }
+                    in.close();
+                    small.close();
+                    setResult(new String(buf.toByteArray()));
+                } catch (IOException ioe) {
+                    setResult(ioe.toString());
+                }
+            }
+        };
+        client.setPriority(Thread.MIN_PRIORITY);
+        client.start();
+
+        synchronized (HttpPipelining.class) {
+            while (!pipelined) {
+                HttpPipelining.class.wait();
+            }
+        }
+
+        // Abandon the big body. More of it is left than is drained on close.
+        big.close();
+
+        client.join();
+        check("pipelined response body", SMALL.equals(result));
+        System.out.println("HttpPipelining passed");
+        System.exit(0);
+    }
+
+    static synchronized void setResult(String value) {
+        result = value;
+    }
+
+    static void check(String what, boolean b) {
+        if (!b) {
+            System.out.println("HttpPipelining failed: " + what + " (result=" + result + ")");
+            System.exit(1);
+        }
+    }
+
+    /**
+     * Serves the requests on one connection.
+     */
+    static void serve(StreamConnection con) {
+        try {
+            InputStream in = con.openInputStream();
+            OutputStream out = con.openOutputStream();
+            String path;
+            while ((path = readRequest(in)) != null) {
+                if (path.equals("/big")) {
+                    out.write(("HTTP/1.1 200 OK\r\nContent-Length: " + BIG + "\r\n\r\n").getBytes());
+                    byte[] data = new byte[1024];
+                    for (int i = 0; i != data.length; ++i) {
+                        data[i] = 'x';
+                    }
+                    out.write(data);
+                    out.flush();
+
+                    // Hold back the rest of the body until the next request arrives
+                    String next = readRequest(in);
+                    synchronized (HttpPipelining.class) {
+                        pipelined = true;
+                        HttpPipelining.class.notifyAll();
+                    }
+                    try {
+                        for (int sent = data.length; sent < BIG; sent += data.length) {
+                            out.write(data);
+                        }
+                        out.flush();
+                    } catch (IOException ioe) {
+                        break; // The client closed the connection after abandoning the body
+                    }
+                    if (next == null) {
+                        break;
+                    }
+                    path = next;
+                }
+                out.write(("HTTP/1.1 200 OK\r\nContent-Length: " + SMALL.length() + "\r\n\r\n" + SMALL).getBytes());
+                out.flush();
+            }
+            out.close();
+            in.close();
+            con.close();
+        } catch (IOException ioe) {
+        }
+    }
+
+    /**
+     * Reads the request line and headers of a request.
+     *
+     * @return the path of the request or null if the connection was closed
+     */
+    static String readRequest(InputStream in) throws IOException {
+        String requestLine = readLine(in);
+        if (requestLine == null) {
+            return null;
+        }
+        String line;
+        while ((line = readLine(in)) != null && line.length() != 0) {
+        }
+        int start = requestLine.indexOf(' ') + 1;
+        return requestLine.substring(start, requestLine.indexOf(' ', start));
+    }
+
+    static String readLine(InputStream in) throws IOException {
+        StringBuffer buf = new StringBuffer();
+        int ch;
+        while ((ch = in.read()) != '\n') {
+            if (ch == -1) {
+                return null;
+            }
+            if (ch != '\r') {
+                buf.append((char)ch);
+            }
+        }
+        return buf.toString();
+    }
+}
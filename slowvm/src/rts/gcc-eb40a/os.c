@@ -46,6 +46,14 @@ void startTicker(int interval) {
     exit(0);
 }
 
+/*
+ * There is no timer to drive the preemption of application threads so
+ * they are preempted by counting backward branches.
+ */
+#define osStartTimeSlicer(micros) false
+#define osTimeSliceTicks()        0
+#define osClearTimeSliceTicks()   /**/
+
 void wait() {
 	unsigned int i, j;
 	for (i = 1; i<350000; i++) {
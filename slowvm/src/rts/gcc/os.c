@@ -54,6 +54,44 @@ void startTicker(int interval) {
     exit(0);
 }
 
+/*
+ * The number of time slice timer ticks that have not yet been consumed by the interpreter.
+ */
+static volatile int timeSliceTicks;
+
+static void timeSliceTick(int sig) {
+    timeSliceTicks++;
+}
+
+/**
+ * Starts the periodic timer that drives the preemption of application threads.
+ * The timer measures the CPU time of the process so that it does not interrupt
+ * the VM while it is blocked waiting for an event.
+ *
+ * @param micros the timer period in microseconds
+ * @return true if the timer was started
+ */
+boolean osStartTimeSlicer(int micros) {
+    struct sigaction sa;
+    struct itimerval timer;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = timeSliceTick;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGVTALRM, &sa, NULL) != 0) {
+        return false;
+    }
+
+    timer.it_interval.tv_sec  = micros / 1000000;
+    timer.it_interval.tv_usec = micros % 1000000;
+    timer.it_value = timer.it_interval;
+    return setitimer(ITIMER_VIRTUAL, &timer, NULL) == 0;
+}
+
+#define osTimeSliceTicks()      timeSliceTicks
+#define osClearTimeSliceTicks() (timeSliceTicks = 0)
+
 #define osloop()        /**/
 #define osbackbranch()  /**/
 #define osfinish()      /**/
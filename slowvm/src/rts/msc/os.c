@@ -104,7 +104,7 @@ jint createJVM(JavaVM **jvm, void **env, void *args) {
 int sleepTime;
 int ticks;
 
-static void ticker(void) {
+static void ticker(void *arg) {
     for(;;) {
         Sleep(sleepTime);
         ticks++;
@@ -116,7 +116,7 @@ void osprofstart(int interval) {
 #ifdef _MT
     if (sleepTime > 0) {
         printf("********** Time profiling set to %d ms **********\n", sleepTime);
-        _beginthread((void (*))ticker, 0, 0);
+        _beginthread(ticker, 0, 0);
     }
 #else
     fprintf(stderr, "No MT -- Profiling not implemented");
@@ -136,6 +136,39 @@ void osprofstart(int interval) {
 
 
 
+/*
+ * The number of time slice timer ticks that have not yet been consumed by the interpreter.
+ */
+static volatile int timeSliceTicks;
+static int timeSliceMillis;
+
+static void timeSlicer(void *arg) {
+    for(;;) {
+        Sleep(timeSliceMillis);
+        timeSliceTicks++;
+    }
+}
+
+/**
+ * Starts the periodic timer that drives the preemption of application threads.
+ * The period is rounded up to a whole number of milliseconds.
+ *
+ * @param micros the timer period in microseconds
+ * @return true if the timer was started
+ */
+boolean osStartTimeSlicer(int micros) {
+#ifdef _MT
+    timeSliceMillis = (micros + 999) / 1000;
+    return _beginthread(timeSlicer, 0, 0) != -1;
+#else
+    return false;
+#endif
+}
+
+#define osTimeSliceTicks()      timeSliceTicks
+#define osClearTimeSliceTicks() (timeSliceTicks = 0)
+
+
 #undef VOID
 
 #define osloop()        /**/
@@ -0,0 +1,341 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM.
+ */
+
+/*
+ * The primitive array kernels behind the native methods of com.sun.squawk.util.Arrays.
+ * They are only used for arrays of the integral types and booleans. All element
+ * accesses go through the typed memory interface so that the type map is kept
+ * up to date when the VM is built with TYPEMAP.
+ */
+
+/**
+ * The size of the ranges that are sorted with an insertion sort.
+ */
+#define ARRAYS_INSERTION_SORT_THRESHOLD 16
+
+/**
+ * Gets the class identifier of the component type of an array.
+ *
+ * @param array the array
+ * @return the class identifier
+ */
+int arraysGetComponentCID(Address array) {
+    return java_lang_Class_classID(java_lang_Class_componentType(getClass(array)));
+}
+
+/**
+ * Loads an element of a primitive array.
+ *
+ * @param array the array
+ * @param cid   the class identifier of the array's component type
+ * @param index the index of the element
+ * @return the value of the element extended to 64 bits
+ */
+jlong arraysGetElement(Address array, int cid, int index) {
+    switch (cid) {
+        case CID_BOOLEAN:
+        case CID_BYTE:  return getByte(array, index);
+        case CID_CHAR:  return getUShort(array, index);
+        case CID_SHORT: return getShort(array, index);
+        case CID_INT:   return getInt(array, index);
+        case CID_LONG:  return getLong(array, index);
+        default: fatalVMError("bad primitive array type");
+    }
+    return 0;
+}
+
+/**
+ * Stores an element of a primitive array.
+ *
+ * @param array the array
+ * @param cid   the class identifier of the array's component type
+ * @param index the index of the element
+ * @param value the value, truncated to the component type
+ */
+void arraysSetElement(Address array, int cid, int index, jlong value) {
+    switch (cid) {
+        case CID_BOOLEAN:
+        case CID_BYTE:  setByte(array, index, (int)value);  break;
+        case CID_CHAR:
+        case CID_SHORT: setShort(array, index, (int)value); break;
+        case CID_INT:   setInt(array, index, (int)value);   break;
+        case CID_LONG:  setLong(array, index, value);       break;
+        default: fatalVMError("bad primitive array type");
+    }
+}
+
+/*-----------------------------------------------------------------------*\
+ *                                Sorting                                *
+\*-----------------------------------------------------------------------*/
+
+/**
+ * Sorts a buffer of values with an insertion sort.
+ *
+ * @param a the values
+ * @param n the number of values
+ */
+void arraysInsertionSort(jlong *a, int n) {
+    int i;
+    for (i = 1; i < n; i++) {
+        jlong value = a[i];
+        int j = i;
+        while (j > 0 && a[j - 1] > value) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = value;
+    }
+}
+
+/**
+ * Sorts a buffer of values with a heap sort.
+ *
+ * @param a the values
+ * @param n the number of values
+ */
+void arraysHeapSort(jlong *a, int n) {
+    int start = n / 2;
+    int end = n;
+    while (end > 1) {
+        int root, child;
+        jlong value;
+        if (start > 0) {
+            value = a[--start];
+        } else {
+            value = a[--end];
+            a[end] = a[0];
+        }
+        root = start;
+        while ((child = 2 * root + 1) < end) {
+            if (child + 1 < end && a[child + 1] > a[child]) {
+                child++;
+            }
+            if (a[child] <= value) {
+                break;
+            }
+            a[root] = a[child];
+            root = child;
+        }
+        a[root] = value;
+    }
+}
+
+/**
+ * Sorts a buffer of values with an introsort: a median of three quicksort
+ * that switches to a heap sort for ranges that partition badly and to an
+ * insertion sort for small ranges.
+ *
+ * @param a     the values
+ * @param n     the number of values
+ * @param depth the number of partitioning steps left before switching to a heap sort
+ */
+void arraysIntroSort(jlong *a, int n, int depth) {
+    while (n > ARRAYS_INSERTION_SORT_THRESHOLD) {
+        jlong pivot, t;
+        int i, j;
+        int mid = n / 2;
+        if (depth-- == 0) {
+            arraysHeapSort(a, n);
+            return;
+        }
+
+        /*
+         * Order a[0], a[mid] and a[n-1] and use the median as the pivot.
+         */
+        if (a[mid] < a[0])     { t = a[mid];   a[mid] = a[0];     a[0] = t; }
+        if (a[n - 1] < a[mid]) { t = a[n - 1]; a[n - 1] = a[mid]; a[mid] = t;
+            if (a[mid] < a[0]) { t = a[mid];   a[mid] = a[0];     a[0] = t; }
+        }
+        pivot = a[mid];
+
+        /*
+         * Hoare partition. a[0] and a[n-1] act as sentinels.
+         */
+        i = 0;
+        j = n - 1;
+        for (;;) {
+            do { i++; } while (a[i] < pivot);
+            do { j--; } while (a[j] > pivot);
+            if (i >= j) {
+                break;
+            }
+            t = a[i]; a[i] = a[j]; a[j] = t;
+        }
+
+        /*
+         * Recurse into the smaller part and loop on the larger one.
+         */
+        if (j + 1 < n - j - 1) {
+            arraysIntroSort(a, j + 1, depth);
+            a += j + 1;
+            n -= j + 1;
+        } else {
+            arraysIntroSort(a + j + 1, n - j - 1, depth);
+            n = j + 1;
+        }
+    }
+    arraysInsertionSort(a, n);
+}
+
+/**
+ * Sorts a range of a byte array with a counting sort.
+ *
+ * @param array     the array
+ * @param fromIndex the index of the first element (inclusive) to be sorted
+ * @param toIndex   the index of the last element (exclusive) to be sorted
+ */
+void arraysCountingSortBytes(Address array, int fromIndex, int toIndex) {
+    int counts[256];
+    int i, value;
+    memset(counts, 0, sizeof(counts));
+    for (i = fromIndex; i < toIndex; i++) {
+        counts[getByte(array, i) + 128]++;
+    }
+    i = fromIndex;
+    for (value = 0; value < 256; value++) {
+        int count = counts[value];
+        while (count-- > 0) {
+            setByte(array, i++, value - 128);
+        }
+    }
+}
+
+/**
+ * Sorts a range of a primitive array into ascending numerical order.
+ *
+ * @param array     the array
+ * @param fromIndex the index of the first element (inclusive) to be sorted
+ * @param toIndex   the index of the last element (exclusive) to be sorted
+ * @return false if the buffer needed for the sort could not be allocated
+ */
+boolean arraysSort(Address array, int fromIndex, int toIndex) {
+    int cid = arraysGetComponentCID(array);
+    int n = toIndex - fromIndex;
+    int depth = 0;
+    int i;
+    jlong *buffer;
+
+    if (n < 2) {
+        return true;
+    }
+    if (cid == CID_BYTE) {
+        arraysCountingSortBytes(array, fromIndex, toIndex);
+        return true;
+    }
+
+    buffer = (jlong *)malloc(n * sizeof(jlong));
+    if (buffer == null) {
+        return false;
+    }
+    for (i = 0; i < n; i++) {
+        buffer[i] = arraysGetElement(array, cid, fromIndex + i);
+    }
+    for (i = n; i > 1; i >>= 1) {
+        depth += 2;
+    }
+    arraysIntroSort(buffer, n, depth);
+    for (i = 0; i < n; i++) {
+        arraysSetElement(array, cid, fromIndex + i, buffer[i]);
+    }
+    free(buffer);
+    return true;
+}
+
+/*-----------------------------------------------------------------------*\
+ *                           Searching, comparing and filling            *
+\*-----------------------------------------------------------------------*/
+
+/**
+ * Searches a range of a sorted primitive array for a value. This probes the
+ * same elements as the Java implementation so that the same index is returned
+ * when the array contains duplicates of the key.
+ *
+ * @param array     the array
+ * @param fromIndex the index of the first element (inclusive) to be searched
+ * @param toIndex   the index of the last element (exclusive) to be searched
+ * @param key       the value to be searched for
+ * @return the index of the key or (-(insertion point) - 1)
+ */
+int arraysBinarySearch(Address array, int fromIndex, int toIndex, jlong key) {
+    int cid = arraysGetComponentCID(array);
+    int low = fromIndex;
+    int high = toIndex - 1;
+    while (low <= high) {
+        int mid = (low + high) >> 1;
+        jlong midVal = arraysGetElement(array, cid, mid);
+        if (midVal < key) {
+            low = mid + 1;
+        } else if (midVal > key) {
+            high = mid - 1;
+        } else {
+            return mid;
+        }
+    }
+    return -(low + 1);
+}
+
+/**
+ * Compares the first elements of two primitive arrays of the same type.
+ *
+ * @param a      one array
+ * @param a2     the other array
+ * @param length the number of elements to compare
+ * @return true if the elements are equal
+ */
+boolean arraysEquals(Address a, Address a2, int length) {
+    int cid = arraysGetComponentCID(a);
+    int i;
+    if (!TYPEMAP) {
+        return memcmp(a, a2, length * getDataSize(java_lang_Class_componentType(getClass(a)))) == 0;
+    }
+    for (i = 0; i < length; i++) {
+        if (arraysGetElement(a, cid, i) != arraysGetElement(a2, cid, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Assigns a value to each element of a range of a primitive array.
+ *
+ * @param array     the array
+ * @param fromIndex the index of the first element (inclusive) to be filled
+ * @param toIndex   the index of the last element (exclusive) to be filled
+ * @param value     the value, truncated to the component type
+ */
+void arraysFill(Address array, int fromIndex, int toIndex, jlong value) {
+    int cid = arraysGetComponentCID(array);
+    int i;
+    if (!TYPEMAP && (cid == CID_BYTE || cid == CID_BOOLEAN)) {
+        memset(Address_add(array, fromIndex), (int)value, toIndex - fromIndex);
+        return;
+    }
+    switch (cid) {
+        case CID_CHAR:
+        case CID_SHORT: {
+            for (i = fromIndex; i < toIndex; i++) {
+                setShort(array, i, (int)value);
+            }
+            break;
+        }
+        case CID_INT: {
+            for (i = fromIndex; i < toIndex; i++) {
+                setInt(array, i, (int)value);
+            }
+            break;
+        }
+        default: {
+            for (i = fromIndex; i < toIndex; i++) {
+                arraysSetElement(array, cid, i, value);
+            }
+            break;
+        }
+    }
+}
@@ -6,6 +6,142 @@ inline static jlong makeLong(int high, int low) {
     return (((jlong)high) << 32) | (((jlong)low) & 0x00000000FFFFFFFFL);
 }
 
+/**
+ * The size of the buffer used to narrow 16-bit strings before they are printed.
+ */
+#define PRINT_BUFFER_SIZE 256
+
+/**
+ * Applies the flush policy to a VM print stream after something was printed to it.
+ *
+ * @param out      the stream that was printed to
+ * @param newline  true if the printed output contained a newline
+ */
+static void flushAfterPrint(FILE *out, boolean newline) {
+    switch (flushPolicy) {
+        case FLUSH_LINE: {
+            if (newline) {
+                fflush(out);
+            }
+            break;
+        }
+        case FLUSH_TIME: {
+            jlong now = sysTimeMillis();
+            if (now - lastFlushTime >= flushInterval) {
+                fflush(out);
+                lastFlushTime = now;
+            } else {
+                flushPending = true;
+            }
+            break;
+        }
+        default: {
+            break; /* FLUSH_SIZE and FLUSH_EXPLICIT leave it to the stdio buffer */
+        }
+    }
+}
+
+/**
+ * Flushes the output left buffered by the FLUSH_TIME policy once the flush interval
+ * has passed, even if nothing else is printed. This is called for every channel
+ * operation, including the one the VM blocks in when all threads are waiting.
+ *
+ * @param blocking  true if the VM may block in the pending channel operation
+ */
+static void flushPendingOutput(boolean blocking) {
+    if (flushPending) {
+        jlong now = sysTimeMillis();
+        if (blocking || now - lastFlushTime >= flushInterval) {
+            int i;
+            for (i = 0 ; i < MAX_STREAMS ; i++) {
+                if (streams[i] != null) {
+                    fflush(streams[i]);
+                }
+            }
+            lastFlushTime = now;
+            flushPending = false;
+        }
+    }
+}
+
+/**
+ * Applies the buffering required by the flush policy to a VM print stream. This
+ * must be called before anything is written to a newly opened stream.
+ *
+ * @param out   the stream
+ */
+static void applyFlushPolicy(FILE *out) {
+    if (flushPolicy == FLUSH_SIZE && flushBufferSize > 0) {
+        setvbuf(out, null, _IOFBF, flushBufferSize);
+    }
+}
+
+/**
+ * Prints a block of bytes to a VM print stream with a single write.
+ *
+ * @param out   the stream to print to
+ * @param buf   the bytes to print
+ * @param lth   the number of bytes to print
+ */
+static void printBytes(FILE *out, char *buf, int lth) {
+    fwrite(buf, 1, lth, out);
+    flushAfterPrint(out, flushPolicy == FLUSH_LINE && memchr(buf, '\n', lth) != null);
+}
+
+/**
+ * Sets the policy for flushing the VM print streams.
+ *
+ * @param policy    one of the FLUSH_... constants
+ * @param parameter the buffer size in bytes for FLUSH_SIZE, the interval in
+ *                  milliseconds for FLUSH_TIME and ignored otherwise
+ */
+void setFlushPolicy(int policy, int parameter) {
+    flushPolicy = policy;
+    if (policy == FLUSH_SIZE && parameter > 0) {
+        int i;
+        flushBufferSize = parameter;
+        for (i = 0 ; i < MAX_STREAMS ; i++) {
+            if (streams[i] != null) {
+                fflush(streams[i]);
+                applyFlushPolicy(streams[i]);
+            }
+        }
+    } else if (policy == FLUSH_TIME) {
+        flushInterval = parameter;
+    }
+}
+
+/**
+ * Determines if the pending channel operation is a leaf operation. A leaf
+ * operation neither allocates nor touches any Java heap structure other than
+ * the raw bytes of its parameters and so it can be executed inline on the
+ * current thread without switching to the service thread.
+ *
+ * @return true if the pending operation can be executed inline
+ */
+boolean cioIsLeaf(void) {
+    switch (java_lang_ServiceOperation_op) {
+        case ChannelConstants_INTERNAL_SETSTREAM:
+        case ChannelConstants_INTERNAL_GETTIME:
+        case ChannelConstants_INTERNAL_PRINTCHAR:
+        case ChannelConstants_INTERNAL_PRINTSTRING:
+        case ChannelConstants_INTERNAL_PRINTBYTES:
+        case ChannelConstants_INTERNAL_PRINTINT:
+        case ChannelConstants_INTERNAL_PRINTLONG:
+        case ChannelConstants_INTERNAL_FLUSHSTREAM:
+        case ChannelConstants_INTERNAL_GETPATHSEPARATORCHAR:
+        case ChannelConstants_INTERNAL_GETFILESEPARATORCHAR: {
+            return true;
+        }
+        case ChannelConstants_INTERNAL_COPYBYTES: {
+            return java_lang_ServiceOperation_i4 == 0; /* Not for copies into NVM */
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
 /**
  * Execute a channel operation.
  */
@@ -23,15 +159,23 @@ inline static jlong makeLong(int high, int low) {
     Address o2      = java_lang_ServiceOperation_o2;
     FILE   *vmOut   = streams[currentStream];
 
+    flushPendingOutput(op == ChannelConstants_GLOBAL_WAITFOREVENT);
+
     switch (op) {
 
         case ChannelConstants_INTERNAL_SETSTREAM: {
             java_lang_ServiceOperation_result = currentStream;
+            if (i1 != currentStream && (flushPolicy == FLUSH_LINE || flushPolicy == FLUSH_TIME)) {
+                fflush(vmOut); /* Preserve the ordering of output interleaved on different streams */
+            }
             currentStream = i1;
             if (streams[currentStream] == null) {
                 switch(currentStream) {
                     case java_lang_VM_STREAM_SYMBOLS: {
                         streams[currentStream] = fopen("squawk_dynamic.sym", "w");
+                        if (streams[currentStream] != null) {
+                            applyFlushPolicy(streams[currentStream]);
+                        }
                         break;
                     }
                     default: {
@@ -44,45 +188,52 @@ inline static jlong makeLong(int high, int low) {
         }
 
         case ChannelConstants_INTERNAL_PRINTSTRING: {
-            int i;
             Address str = o1;
             if (str == null) {
-                fprintf(vmOut, "null");
+                printBytes(vmOut, "null", 4);
             } else {
                 int lth = getArrayLength(str);
 #ifdef UNICODE
                 Address cls = getClass(str);
                 if (java_lang_Class_classID(cls) == java_lang_StringOfBytes) {
 #endif
-                    unsigned char *chars = (unsigned char *)str;
-                    for (i = 0 ; i < lth ; i++) {
-                        fprintf(vmOut, "%c", chars[i]);
-                    }
+                    printBytes(vmOut, (char *)str, lth);
 #ifdef UNICODE
                 } else {
                     unsigned short *chars = (unsigned short *)str;
+                    char buf[PRINT_BUFFER_SIZE];
+                    int i;
                     if (java_lang_Class_classID(cls) != java_lang_String) {
                         fatalVMError("java_lang_VM_printString was not passed a string");
                     }
-                    for (i = 0 ; i < lth ; i++) {
-                        fprintf(vmOut, "%c", chars[i]);
+                    for (i = 0 ; i < lth ; i += PRINT_BUFFER_SIZE) {
+                        int count = (lth - i < PRINT_BUFFER_SIZE) ? lth - i : PRINT_BUFFER_SIZE;
+                        int j;
+                        for (j = 0 ; j < count ; j++) {
+                            buf[j] = (char)chars[i + j];
+                        }
+                        printBytes(vmOut, buf, count);
                     }
                 }
 #endif
             }
-            fflush(vmOut);
+            break;
+        }
+
+        case ChannelConstants_INTERNAL_PRINTBYTES: {
+            printBytes(vmOut, (char *)Address_add(o1, i1), i2);
             break;
         }
 
         case ChannelConstants_INTERNAL_PRINTCHAR: {
-            fprintf(vmOut, "%c", i1);
-            fflush(vmOut);
+            fputc(i1, vmOut);
+            flushAfterPrint(vmOut, i1 == '\n');
             break;
         }
 
         case ChannelConstants_INTERNAL_PRINTINT: {
             fprintf(vmOut, "%d", i1);
-            fflush(vmOut);
+            flushAfterPrint(vmOut, false);
             break;
         }
 
@@ -90,7 +241,7 @@ inline static jlong makeLong(int high, int low) {
             //ujlong val = ((ujlong)i1) << 32 | ((ujlong)i2);
             jlong val = makeLong(i1, i2);
             fprintf(vmOut, format("%A"), (UWord)val);
-            fflush(vmOut);
+            flushAfterPrint(vmOut, false);
             break;
         }
 
@@ -98,7 +249,7 @@ inline static jlong makeLong(int high, int low) {
             //jlong val = ((jlong)i1) << 32 | ((jlong)i2);
             jlong val = makeLong(i1, i2);
             fprintf(vmOut, format("%W"), val);
-            fflush(vmOut);
+            flushAfterPrint(vmOut, false);
             break;
         }
 
@@ -106,7 +257,7 @@ inline static jlong makeLong(int high, int low) {
             //ujlong val = ((ujlong)i1) << 32 | ((ujlong)i2);
             jlong val = makeLong(i1, i2);
             fprintf(vmOut, format("%L"), val);
-            fflush(vmOut);
+            flushAfterPrint(vmOut, false);
             break;
         }
 
@@ -116,7 +267,17 @@ inline static jlong makeLong(int high, int low) {
             if (hieq(val, java_lang_VM_romStart) && lo(val, java_lang_VM_romEnd)) {
                 fprintf(vmOut, format(" (image @ %W)"), Address_sub(val, java_lang_VM_romStart));
             }
-            fflush(vmOut);
+            flushAfterPrint(vmOut, false);
+            break;
+        }
+
+        case ChannelConstants_INTERNAL_FLUSHSTREAM: {
+            if (i1 < 0 || i1 >= MAX_STREAMS) {
+                fatalVMError("Bad INTERNAL_FLUSHSTREAM");
+            }
+            if (streams[i1] != null) {
+                fflush(streams[i1]);
+            }
             break;
         }
 
@@ -137,7 +298,7 @@ inline static jlong makeLong(int high, int low) {
 #else
             fprintf(vmOut, "Global oop:%d", i1);
 #endif
-            fflush(vmOut);
+            flushAfterPrint(vmOut, false);
             break;
         }
 
@@ -170,19 +331,24 @@ inline static jlong makeLong(int high, int low) {
             break;
         }
 
-        case ChannelConstants_INTERNAL_GETTIME_HIGH: {
-            lastTime = sysTimeMillis();
-            java_lang_ServiceOperation_result = (int)(lastTime >> 32);
+        case ChannelConstants_INTERNAL_GETTIME: {
+            jlong now = sysTimeMillis();
+            java_lang_ServiceOperation_result     = (int)now;
+            java_lang_ServiceOperation_resultHigh = (int)(now >> 32);
             break;
         }
 
-        case ChannelConstants_INTERNAL_GETTIME_LOW: {
-            java_lang_ServiceOperation_result = (int)lastTime;
+        case ChannelConstants_INTERNAL_STOPVM: {
+            stopVM(i1);
             break;
         }
 
-        case ChannelConstants_INTERNAL_STOPVM: {
-            stopVM(i1);
+        case ChannelConstants_INTERNAL_ZYGOTE: {
+#ifdef ZYGOTE
+            java_lang_ServiceOperation_result = zygoteAwaitRequest();
+#else
+            java_lang_ServiceOperation_result = -1;
+#endif
             break;
         }
 
@@ -9,6 +9,14 @@
 
 #define MAX_STREAMS 4
 
+/*
+ * The policies for flushing the VM print streams (see the -Xflush: option).
+ */
+#define FLUSH_LINE      0                   /* Flush after output containing a newline (default). */
+#define FLUSH_SIZE      1                   /* Flush only when the stdio buffer is full. */
+#define FLUSH_TIME      2                   /* Flush if output is written more than an interval after the last flush. */
+#define FLUSH_EXPLICIT  3                   /* Flush only on INTERNAL_FLUSHSTREAM and VM exit. */
+
 /**
  * This struct encapsulates all the globals in the Squawk VM. This simplifies
  * (re)initialization of this state when the Squawk VM is being used as a
@@ -33,7 +41,7 @@ struct {
 
     UWordAddress sl;                        /* The stack limit. */
     UWordAddress ss;                        /* The stack start. */
-    int          bc;                        /* The branch counter. */
+    int          bc;                        /* The branch counter (or the time slice tick counter if timeSlice != 0). */
 
     int         Ints[GLOBAL_INT_COUNT];     /* Storage for the primitive typed Java globals. */
     Address     Addrs[GLOBAL_ADDR_COUNT];   /* Storage for the primitive typed Java globals. */
@@ -46,7 +54,12 @@ struct {
     JavaVM     *jvm;                        /* Handle to the JVM created via the Invocation API. This will be null if Squawk was called from Java code. */
     FILE       *streams[MAX_STREAMS];       /* The file streams to which the VM printing directives sent. */
     int         currentStream;              /* The currently selected stream */
-    ujlong      lastTime;                   /* Time for INTERNAL_GETTIME_LOW */
+    int         flushPolicy;                /* The policy for flushing the VM print streams (one of the FLUSH_... constants) */
+    int         flushInterval;              /* The interval (in milliseconds) between flushes for FLUSH_TIME */
+    int         timeSlice;                  /* The time slice (in microseconds) of a thread of normal priority or 0 if threads are preempted by counting backward branches */
+    int         flushBufferSize;            /* The size (in bytes) of the stdio buffers for FLUSH_SIZE */
+    jlong       lastFlushTime;              /* The time of the last flush for FLUSH_TIME */
+    boolean     flushPending;               /* Specifies if there is output that FLUSH_TIME has not yet flushed */
     jclass      channelIO_clazz;            /* JNI handle to com.sun.squawk.vm.ChannelIO. */
     jmethodID   channelIO_execute;          /* JNI handle to com.sun.squawk.vm.ChannelIO.execute(...) */
 
@@ -59,6 +72,13 @@ struct {
     int         io_ops_count;
 #endif
 
+#ifdef ZYGOTE
+    char       *zygotePath;                 /* The path of the socket on which the VM accepts launch requests as a zygote or null. */
+    Address     zygoteRequest;              /* The buffer in which a forked child receives the command line arguments of its launch request. */
+    char       *jvmArgs[MAX_JVM_ARGS];      /* The '-J' flags with which a forked child creates its embedded JVM. */
+    int         jvmArgsCount;               /* The number of flags in jvmArgs. */
+#endif
+
     FILE       *traceFile;                  /* The trace file name */
     boolean     traceFileOpen;              /* Specifies if the trace file has been opened. */
     int         traceLastThreadID;          /* Specifies the thread ID at the last call to trace() */
@@ -109,7 +129,6 @@ struct {
 #define sl                                  Globals.sl
 #define ss                                  Globals.ss
 #define bc                                  Globals.bc
-#define lastTime                            Globals.lastTime
 #define Ints                                Globals.Ints
 #define Addrs                               Globals.Addrs
 #define Oops                                Globals.Oops
@@ -132,6 +151,13 @@ struct {
 #define io_ops_count                        Globals.io_ops_count
 #endif
 
+#ifdef ZYGOTE
+#define zygotePath                          Globals.zygotePath
+#define zygoteRequest                       Globals.zygoteRequest
+#define jvmArgs                             Globals.jvmArgs
+#define jvmArgsCount                        Globals.jvmArgsCount
+#endif
+
 #define cachedClassState                    Globals.cachedClassState
 #define cachedClass                         Globals.cachedClass
 #define cachedClassAccesses                 Globals.cachedClassAccesses
@@ -144,6 +170,12 @@ struct {
 
 #define streams                             Globals.streams
 #define currentStream                       Globals.currentStream
+#define flushPolicy                         Globals.flushPolicy
+#define flushInterval                       Globals.flushInterval
+#define flushBufferSize                     Globals.flushBufferSize
+#define lastFlushTime                       Globals.lastFlushTime
+#define flushPending                        Globals.flushPending
+#define timeSlice                           Globals.timeSlice
 
 #define channelIO_clazz                     Globals.channelIO_clazz
 #define channelIO_execute                   Globals.channelIO_execute
@@ -195,6 +227,7 @@ int initializeGlobals() {
     streams[java_lang_VM_STREAM_STDOUT] = stdout;
     streams[java_lang_VM_STREAM_STDERR] = stderr;
     currentStream = java_lang_VM_STREAM_STDERR;
+    timeSlice = DEFAULT_TIME_SLICE;
 
 #ifdef TRACE
     setTraceStart(TRACESTART);
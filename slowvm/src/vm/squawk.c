@@ -133,9 +133,11 @@ void printStackTracePrim(int opcode, ByteAddress traceIP, UWordAddress traceFP,
 #define SERVICE_CHUNK_SIZE_MINUS2WORDS (SERVICE_CHUNK_SIZE - TWOWORDS)
 #define DEFAULT_RAM_SIZE   (8*1024*1024)
 #define DEFAULT_NVM_SIZE   (8*1024*1024)
-#define TIMEQUANTA 1000
+#define TIMEQUANTA 1000 /* Backward branches per time slice of a thread of normal priority */
+#define DEFAULT_TIME_SLICE 10000 /* Microseconds per time slice of a thread of normal priority */
 #define MAX_BUFFERS 10
 #define MAX_JVM_ARGS 20
+#define ZYGOTE_REQUEST_SIZE 4096 /* Bytes reserved for the command line arguments of a zygote launch request */
 
 /**
  * The tracing limits.
@@ -383,11 +385,32 @@ void freeBuffers() {
 #include "lisp2.c"
 #endif /* WRITE_BARRIER */
 
+/*
+ * Forward declarations of the I/O system routines used by the bytecodes.
+ */
+boolean cioIsLeaf(void);
+#ifdef ZYGOTE
+int zygoteAwaitRequest(void);
+#endif
+
+/*
+ * Forward declarations of the primitive array kernels used by the bytecodes.
+ */
+boolean arraysSort(Address array, int fromIndex, int toIndex);
+int arraysBinarySearch(Address array, int fromIndex, int toIndex, jlong key);
+boolean arraysEquals(Address a, Address a2, int length);
+void arraysFill(Address array, int fromIndex, int toIndex, jlong value);
+
 /*
  * Include the switch and bytecode routines.
  */
 #include "bytecodes.c"
 
+/*
+ * Include the primitive array kernels.
+ */
+#include "arrays.c"
+
 /*
  * Include the I/O system
  */
@@ -539,6 +562,7 @@ void printCacheStats() {
         fprintf(stderr, " Monitor:%6.2f%%", (((double)pendingMonitorAccesses)/count)*100);
         fprintf(stderr, " Exit:%6.2f%%",    (((double)java_lang_GC_monitorExitCount)/count)*100);
         fprintf(stderr, " New:%6.2f%%",    (((double)newCount)/count)*100);
+        fprintf(stderr, " Throw:%6.2f%%",  (((double)throwCount)/count)*100);
     }
 
     fprintf(stderr, "\nHits   - ");
@@ -554,6 +578,9 @@ void printCacheStats() {
     average = (newCount == 0 ? 0 : ((double)newHits) / newCount);
     fprintf(stderr, format(" New:%6.2f%%"), average*100);
     newCount = newHits = 0;
+    average = (throwCount == 0 ? 0 : ((double)throwHits) / throwCount);
+    fprintf(stderr, format(" Throw:%6.2f%%"), average*100);
+    throwCount = throwHits = 0;
     fprintf(stderr, "\n");
 #ifdef TRACE
     fprintf(stderr, format("Extends: %d slots/extend %f\n"), totol_extends, ((double)totol_slots)/totol_extends);
@@ -655,6 +682,17 @@ void usage() {
     printf("    -Xioport:[host:]port  connect to an I/O server via a socket\n");
 #endif
     printf("    -Xnotrap       don't trap VM crashes\n");
+    printf("    -Xflush:<policy>  set the policy for flushing VM console output where 'policy' is one of:\n");
+    printf("                     line:         flush after each line (default)\n");
+    printf("                     size:<n>      flush when 'n' bytes have been buffered\n");
+    printf("                     time:<n>      flush output written 'n' milliseconds or more after the last flush\n");
+    printf("                     explicit:     flush only when requested or when the VM exits\n");
+    printf("    -Xslice:<n>    preempt a thread of normal priority after 'n' microseconds (default=%d)\n", DEFAULT_TIME_SLICE);
+    printf("                   or after %d backward branches if 'n' is 0\n", TIMEQUANTA);
+#ifdef ZYGOTE
+    printf("    -Xzygote:<path> start up and then fork a child VM for each launch request\n");
+    printf("                   received on the local socket 'path'\n");
+#endif
     if (!isLaunchedViaJNI) {
         jvmUsage();
     }
@@ -755,6 +793,13 @@ int writeCStringArray(int length, char **array, int offset) {
     return offset;
 }
 
+#ifdef ZYGOTE
+/*
+ * Include the zygote launch request server.
+ */
+#include "zygote.c"
+#endif
+
 /**
  * Sets up the memory buffer.
  *
@@ -776,6 +821,12 @@ Address setupMemory(int ramSize, int nvmSize, int argc, char *argv[]) {
     int argvTotalSize = calculateSizeForCopyOfCStringArray(argc, argv);
     int offset;
 
+#ifdef ZYGOTE
+    if (zygotePath != null) {
+        argvTotalSize += HDR_BYTES_PER_WORD + ZYGOTE_REQUEST_SIZE;
+    }
+#endif
+
 #ifdef FLASH_MEMORY
     memorySize = 0;
     assume(!TYPEMAP);
@@ -834,6 +885,16 @@ Address setupMemory(int ramSize, int nvmSize, int argc, char *argv[]) {
     java_lang_VM_romFileName = Address_add(memory, offset);
     offset = writeCString(romFileName, offset);
 
+#ifdef ZYGOTE
+    // The arguments of a launch request are copied into a word aligned buffer
+    // after the name of the bootstrap image in a child forked by a zygote
+    if (zygotePath != null) {
+        offset = roundUp(offset, HDR_BYTES_PER_WORD);
+        zygoteRequest = Address_add(memory, offset);
+        offset += ZYGOTE_REQUEST_SIZE;
+    }
+#endif
+
     // Ensure that the buffer did not overflow
     assume(loeq(Address_add(memory, offset), memoryEnd));
 
@@ -916,6 +977,20 @@ Address processArgs(char *argv[], const int argc) {
                     java_lang_GC_traceFlags = parseQuantity(arg+4, "-Xtgc:");
                 } else if (equals(arg, "notrap")) {
                     notrap = true;
+                } else if (equals(arg, "flush:line")) {
+                    setFlushPolicy(FLUSH_LINE, 0);
+                } else if (startsWith(arg, "flush:size:")) {
+                    setFlushPolicy(FLUSH_SIZE, parseQuantity(arg+11, "-Xflush:size:"));
+                } else if (startsWith(arg, "flush:time:")) {
+                    setFlushPolicy(FLUSH_TIME, parseQuantity(arg+11, "-Xflush:time:"));
+                } else if (equals(arg, "flush:explicit")) {
+                    setFlushPolicy(FLUSH_EXPLICIT, 0);
+                } else if (startsWith(arg, "slice:")) {
+                    timeSlice = parseQuantity(arg+6, "-Xslice:");
+#ifdef ZYGOTE
+                } else if (startsWith(arg, "zygote:")) {
+                    zygotePath = arg + 7;
+#endif
 #ifdef TRACE
                 } else if (equals(arg, "terr")) {
                     traceFile = stderr;
@@ -976,8 +1051,18 @@ Address processArgs(char *argv[], const int argc) {
     }
 
     /*
-     * Startup the embedded Hotspot VM if Squawk was not launched via a JNI call
+     * Startup the embedded Hotspot VM if Squawk was not launched via a JNI call.
+     * A zygote defers this to each forked child as the JVM cannot survive a fork.
      */
+#ifdef ZYGOTE
+    if (zygotePath != null) {
+        if (isCalledFromJava) {
+            fatalVMError("-Xzygote cannot be used when Squawk is launched via JNI");
+        }
+        memcpy(jvmArgs, javaVMArgs, javaVMArgsCount * sizeof(char *));
+        jvmArgsCount = javaVMArgsCount;
+    } else
+#endif
     if (!isCalledFromJava) {
         CIO_initialize(null, "squawk.jar", javaVMArgs, javaVMArgsCount);
     }
@@ -1137,6 +1222,18 @@ int Squawk_main(int argc, char *argv[]) {
 #endif
 #endif
 
+    /*
+     * Start the timer that drives thread preemption. A thread gets one tick
+     * per priority level so the timer period is a fraction of the time slice.
+     * Fall back to counting backward branches if there is no timer.
+     */
+    if (timeSlice != 0) {
+        int period = timeSlice / java_lang_Thread_NORM_PRIORITY;
+        if (period <= 0 || !osStartTimeSlicer(period)) {
+            timeSlice = 0;
+        }
+    }
+
 #ifdef DB_DEBUG
     db_prepare();
 #endif
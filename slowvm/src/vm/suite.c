@@ -230,6 +230,12 @@ UWord loadBootstrapSuite(const char *file,
     if (((attributes & java_lang_ObjectMemoryLoader_ATTRIBUTE_32BIT) != 0) == SQUAWK_64) {
         fatalVMError("word size in bootstrap suite is incorrect");
     }
+    if ((attributes & java_lang_ObjectMemoryLoader_ATTRIBUTE_COMPRESSED) != 0) {
+        fatalVMError("bootstrap suite cannot be compressed");
+    }
+    if ((attributes & java_lang_ObjectMemoryLoader_ATTRIBUTE_DELTA) != 0) {
+        fatalVMError("bootstrap suite cannot be a delta");
+    }
 
     /*
      * Read and ignore 'parent_hash'
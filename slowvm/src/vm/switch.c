@@ -520,8 +520,8 @@
                                                   do_lookup(BYTE);                   break;
             case OPC_LOOKUP_S:                    iparmNone();
                                                   do_lookup(SHORT);                  break;
-            case OPC_RES_0:                       iparmNone();
-                                                  do_res(0);                         break;
+            case OPC_ALOAD_UNCHECKED_I:           iparmNone();
+                                                  do_aload_unchecked(INT);           break;
 #ifdef java_lang_VM_doubleToLongBits
             case OPC_IF_EQ_F:                     iparmByte();
             case OPC_IF_EQ_F_WIDE:                do_if(1, EQ, FLOAT);               break;
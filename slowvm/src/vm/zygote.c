@@ -0,0 +1,273 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM.
+ */
+
+/*
+ * A zygote is a VM that has been started with the -Xzygote:<path> option. It loads the
+ * bootstrap suite and starts up the application manager isolate as usual but instead of
+ * running an application it then waits for launch requests on a local socket. It forks
+ * a child process for each request. The child shares the ROM and the initialized heap
+ * of the zygote copy-on-write and runs the application specified by the request with
+ * its standard input, output and error streams connected to the client's socket.
+ *
+ * A launch request is the sequence of command line arguments (options for the
+ * application manager followed by the main class and its arguments) each terminated by
+ * a null byte. The request is ended by an empty argument or by the client shutting
+ * down its side of the connection.
+ */
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#ifdef __sun
+#include <ucred.h>
+#endif
+
+#define ZYGOTE_MAX_ARGS 256
+
+/**
+ * Reads a launch request from a client connection.
+ *
+ * @param  conn    the client connection
+ * @param  buffer  the buffer into which the request is read
+ * @param  size    the size of 'buffer'
+ * @return the number of bytes in the request (including the terminating null bytes) or -1 if
+ *         the request could not be read or does not fit in 'buffer'
+ */
+static int zygoteReadRequest(int conn, char *buffer, int size) {
+    int length = 0;
+    while (length == 0 || buffer[length - 1] != 0 || (length > 1 && buffer[length - 2] != 0)) {
+        int n;
+        if (length == size) {
+            return -1;
+        }
+        n = read(conn, buffer + length, size - length);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            /* The client shut down its side of the connection: the request ends here */
+            if (n < 0 || length == 0 || buffer[length - 1] != 0) {
+                return -1;
+            }
+            break;
+        }
+        length += n;
+
+        /* An empty request consists of a single null byte */
+        if (length == 1 && buffer[0] == 0) {
+            break;
+        }
+    }
+    return length;
+}
+
+/**
+ * Splits a launch request into its arguments.
+ *
+ * @param  request  the request
+ * @param  length   the number of bytes in 'request'
+ * @param  args     the array into which the arguments are written
+ * @return the number of arguments or -1 if there are more than ZYGOTE_MAX_ARGS
+ */
+static int zygoteParseRequest(char *request, int length, char **args) {
+    int argc = 0;
+    int pos = 0;
+    while (pos != length && request[pos] != 0) {
+        if (argc == ZYGOTE_MAX_ARGS) {
+            return -1;
+        }
+        args[argc++] = request + pos;
+        pos += strlen(request + pos) + 1;
+    }
+    return argc;
+}
+
+/**
+ * Sends a reason for rejecting a launch request to the client and closes the connection.
+ *
+ * @param conn  the client connection
+ * @param msg   the reason the request was rejected
+ */
+static void zygoteReject(int conn, const char *msg) {
+    (void)write(conn, msg, strlen(msg));
+    close(conn);
+}
+
+/**
+ * Determines if a client connection was made by a process running as the same user as the zygote.
+ * Only such a client may have code launched in a child, as the child runs with the zygote's
+ * privileges.
+ *
+ * @param conn  the client connection
+ * @return true if the peer's effective user ID could be determined and is the zygote's
+ */
+static boolean zygoteIsTrustedPeer(int conn) {
+#if defined(SO_PEERCRED)
+    /*
+     * The layout of 'struct ucred'. It is declared here as glibc only declares it for _GNU_SOURCE.
+     */
+    struct {
+        pid_t pid;
+        uid_t uid;
+        gid_t gid;
+    } cred;
+    socklen_t length = sizeof(cred);
+    return getsockopt(conn, SOL_SOCKET, SO_PEERCRED, &cred, &length) == 0 && cred.uid == geteuid();
+#elif defined(__sun)
+    ucred_t *cred = null;
+    boolean result;
+    if (getpeerucred(conn, &cred) != 0) {
+        return false;
+    }
+    result = ucred_geteuid(cred) == geteuid();
+    ucred_free(cred);
+    return result;
+#else
+    uid_t uid;
+    gid_t gid;
+    return getpeereid(conn, &uid, &gid) == 0 && uid == geteuid();
+#endif
+}
+
+/**
+ * Removes a socket left behind at the zygote's path by an earlier zygote. Anything other than a
+ * socket is left alone so that a mistyped path cannot delete a file.
+ *
+ * @return false if the path exists and is not a socket
+ */
+static boolean zygoteRemoveStaleSocket(void) {
+    struct stat st;
+    if (lstat(zygotePath, &st) == -1) {
+        return errno == ENOENT;
+    }
+    if (!S_ISSOCK(st.st_mode)) {
+        return false;
+    }
+    return unlink(zygotePath) == 0;
+}
+
+/**
+ * Accepts launch requests on the socket given by the -Xzygote option and forks a child
+ * process for each request. This function only returns in a child process. It has then
+ * replaced the command line arguments in VM.argv with the arguments of its request,
+ * connected the standard streams to the client and created the embedded JVM.
+ *
+ * @return the number of arguments in the request or -1 if the VM is not a zygote
+ */
+int zygoteAwaitRequest(void) {
+    struct sockaddr_un addr;
+    int listener;
+
+    if (zygotePath == null) {
+        return -1;
+    }
+
+    if (strlen(zygotePath) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "zygote socket path too long: %s\n", zygotePath);
+        stopVM(-1);
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, zygotePath);
+
+    if (!zygoteRemoveStaleSocket()) {
+        fprintf(stderr, "zygote socket path exists and is not a socket: %s\n", zygotePath);
+        stopVM(-1);
+    }
+
+    /*
+     * Only the zygote's user may connect to the socket. It is created without group
+     * and other permissions so that there is no window in which anyone else can connect.
+     */
+    if ((listener = socket(AF_UNIX, SOCK_STREAM, 0)) == -1) {
+        perror("zygote");
+        stopVM(-1);
+    } else {
+        mode_t mask = umask(077);
+        int bound = bind(listener, (struct sockaddr *)&addr, sizeof(addr));
+        umask(mask);
+        if (bound == -1 || chmod(zygotePath, 0600) == -1 || listen(listener, 16) == -1) {
+            perror("zygote");
+            stopVM(-1);
+        }
+    }
+
+    /*
+     * The children are never waited for so let the system reap them.
+     */
+    signal(SIGCHLD, SIG_IGN);
+    fprintf(stderr, "Zygote accepting launch requests on %s\n", zygotePath);
+
+    while (true) {
+        char request[ZYGOTE_REQUEST_SIZE];
+        char *args[ZYGOTE_MAX_ARGS];
+        int length;
+        int argc;
+        int pid;
+        int conn = accept(listener, null, null);
+
+        if (conn == -1) {
+            if (errno != EINTR) {
+                perror("zygote accept");
+            }
+            continue;
+        }
+
+        if (!zygoteIsTrustedPeer(conn)) {
+            zygoteReject(conn, "** launch requests are only accepted from the zygote's user **\n");
+            continue;
+        }
+
+        length = zygoteReadRequest(conn, request, sizeof(request));
+        if (length < 0 || (argc = zygoteParseRequest(request, length, args)) < 0 ||
+            calculateSizeForCopyOfCStringArray(argc, args) > ZYGOTE_REQUEST_SIZE) {
+            zygoteReject(conn, "** malformed or oversized launch request **\n");
+            continue;
+        }
+
+        /*
+         * Don't let the child inherit (and later repeat) any buffered output.
+         */
+        fflush(stdout);
+        fflush(stderr);
+
+        pid = fork();
+        if (pid == 0) {
+            close(listener);
+            signal(SIGCHLD, SIG_DFL);
+            dup2(conn, 0);
+            dup2(conn, 1);
+            dup2(conn, 2);
+            if (conn > 2) {
+                close(conn);
+            }
+            zygotePath = null;
+
+            writeCStringArray(argc, args, Address_diff(zygoteRequest, memory));
+            java_lang_VM_argv = zygoteRequest;
+            java_lang_VM_argc = argc;
+
+            /*
+             * Interval timers are not inherited across a fork.
+             */
+            if (timeSlice != 0 && !osStartTimeSlicer(timeSlice / java_lang_Thread_NORM_PRIORITY)) {
+                timeSlice = 0;
+            }
+
+            CIO_initialize(null, "squawk.jar", jvmArgs, jvmArgsCount);
+            return argc;
+        }
+
+        if (pid == -1) {
+            perror("zygote fork");
+            zygoteReject(conn, "** could not fork a VM for the launch request **\n");
+        } else {
+            close(conn);
+        }
+    }
+}
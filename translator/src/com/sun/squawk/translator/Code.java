@@ -215,6 +215,7 @@ public final class Code {
             codeParser = new CodeParser(method, code, constantPool);
             irBuilder = new IRBuilder(codeParser);
             IR ir = irBuilder.getIR();
+            Translator.instance().getPassManager().methodBuilt(ir, method);
 
             /*
              * Add the object references into the table of constants.
@@ -255,6 +256,19 @@ public final class Code {
             }
 /*end[J2ME.DEBUG]*/
 
+            /*
+             * Apply the enabled optimizations to the IR.
+             */
+            Translator.instance().getPassManager().optimize(ir, method);
+
+            /*
+             * Try to compute the values of the static fields initialized by <clinit>
+             * so that the method need not be executed when the class is initialized.
+             */
+            if (VM.isHosted() && method.isStatic() && method.getName().equals("<clinit>")) {
+                new ClinitEvaluator(ir, definingClass).evaluate();
+            }
+
             /*
              * Transform the IR.
              */
@@ -15,6 +15,7 @@ import javax.microedition.io.Connector;
 import com.sun.squawk.util.Assert;
 import com.sun.squawk.io.connections.*;
 import com.sun.squawk.translator.ci.*;
+import com.sun.squawk.translator.ir.IRPassManager;
 import com.sun.squawk.util.Hashtable; // Version without synchronization
 
 /*if[TRANSLATOR.TCKERRORLOGGER]*/
@@ -76,6 +77,38 @@ public final class Translator implements TranslatorInterface {
      */
     private ClasspathConnection classPath;
 
+    /**
+     * The names of the optimization passes enabled for the suites translated by this translator.
+     */
+    private String enabledPasses = "";
+
+    /**
+     * The optimization passes applied to the methods of the currently open suite.
+     */
+    private IRPassManager passManager;
+
+    /**
+     * Sets the optimization passes that are applied to the methods of the suites
+     * subsequently opened by this translator.
+     *
+     * @param names  a comma separated list of pass names, "all" to enable all passes
+     *               or "" to disable all passes
+     * @throws IllegalArgumentException if <code>names</code> contains an unknown pass name
+     */
+    public void setEnabledPasses(String names) {
+        new IRPassManager(names);
+        enabledPasses = names;
+    }
+
+    /**
+     * Gets the optimization passes applied to the methods of the currently open suite.
+     *
+     * @return the pass manager for the open suite
+     */
+    public IRPassManager getPassManager() {
+        return passManager;
+    }
+
     /**
      * {@inheritDoc}
      */
@@ -85,6 +118,7 @@ public final class Translator implements TranslatorInterface {
         instance = this;
         this.suite = suite;
         this.classFiles = new Hashtable();
+        this.passManager = new IRPassManager(enabledPasses);
         try {
             String url = "classpath://" +  suite.getClassPath();
             this.classPath = (ClasspathConnection)Connector.open(url);
@@ -145,6 +179,7 @@ public final class Translator implements TranslatorInterface {
         instance   = null;
         classPath  = null;
         classFiles = null;
+        passManager = null;
     }
 
 
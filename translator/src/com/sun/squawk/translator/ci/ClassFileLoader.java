@@ -17,6 +17,7 @@ import com.sun.squawk.util.*;
 import com.sun.squawk.util.Arrays;
 import com.sun.squawk.vm.CID;
 import com.sun.squawk.util.Vector;    // Version without synchronization
+import com.sun.squawk.util.Hashtable; // Version without synchronization
 
 /*if[TRUSTED]*/
 import com.sun.squawk.csp.*;
@@ -72,6 +73,28 @@ public final class ClassFileLoader implements Context {
         this.classPath = classPath;
     }
 
+    /**
+     * The field access profile used to lay out the instance fields. It maps
+     * the name of each profiled class to a table that maps the name of each of
+     * its accessed instance fields to the number of accesses (as an <code>Integer</code>).
+     */
+    private static Hashtable fieldProfile;
+
+    /**
+     * Sets the field access profile used to lay out the instance fields of the
+     * classes loaded from now on. The fields of a class in the profile are laid out
+     * with the accessed fields first, in order of decreasing access count. The
+     * fields of any other class are only sorted by size.
+     * <p>
+     * The layout of a class never changes once it has been loaded and so classes
+     * whose field offsets are known to the VM must not be in the profile.
+     *
+     * @param profile  the profile or null to use the default layout for all classes
+     */
+    public static void setFieldProfile(Hashtable profile) {
+        fieldProfile = profile;
+    }
+
     /**
      * The connection that is used to find the class files.
      */
@@ -608,7 +631,12 @@ public final class ClassFileLoader implements Context {
          * also provides a simple form of object packing
          */
         if (fieldTables[0].length > 1) {
-            sortFields(fieldTables[0]);
+            Hashtable profile = fieldProfile == null ? null : (Hashtable)fieldProfile.get(klass.getInternalName());
+            if (profile != null) {
+                sortFields(fieldTables[0], profile);
+            } else {
+                sortFields(fieldTables[0]);
+            }
         }
     }
 
@@ -676,6 +704,68 @@ public final class ClassFileLoader implements Context {
         });
     }
 
+    /**
+     * Sorts an array of fields according to a field access profile. The accessed
+     * fields come before the fields that are never accessed. Within each of these
+     * two groups, the fields are sorted by the data size of their types in descending
+     * order so that padding is only required between the groups. Fields of the same
+     * size are sorted with the references first so that the oop map bits for the
+     * class are contiguous and then by access count in descending order.
+     *
+     * @param fields   the array of fields to sort
+     * @param profile  the table mapping field names to access counts
+     */
+    private void sortFields(ClassFileField[] fields, final Hashtable profile) {
+        Arrays.sort(fields, new Comparer() {
+            public int compare(Object o1, Object o2) {
+                if (o1 == o2) {
+                    return 0;
+                }
+
+                ClassFileField f1 = (ClassFileField)o1;
+                ClassFileField f2 = (ClassFileField)o2;
+                int c1 = getAccessCount(f1);
+                int c2 = getAccessCount(f2);
+
+                /*
+                 * Sort accessed fields before the others
+                 */
+                if ((c1 == 0) != (c2 == 0)) {
+                    return c1 == 0 ? 1 : -1;
+                }
+
+                /*
+                 * Sort by data size of field's type
+                 */
+                Klass t1 = f1.getType();
+                Klass t2 = f2.getType();
+                if (t1.getDataSize() != t2.getDataSize()) {
+                    return t1.getDataSize() < t2.getDataSize() ? 1 : -1;
+                }
+
+                /*
+                 * Sort references before primitives
+                 */
+                if (t1.isReferenceType() != t2.isReferenceType()) {
+                    return t1.isReferenceType() ? -1 : 1;
+                }
+
+                /*
+                 * Sort by access count
+                 */
+                if (c1 != c2) {
+                    return c1 < c2 ? 1 : -1;
+                }
+                return 0;
+            }
+
+            private int getAccessCount(ClassFileField field) {
+                Integer count = (Integer)profile.get(field.getName());
+                return count == null ? 0 : count.intValue();
+            }
+        });
+    }
+
     /**
      * Loads one of the class's fields.
      *
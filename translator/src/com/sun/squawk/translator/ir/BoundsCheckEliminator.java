@@ -0,0 +1,361 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Enumeration;
+import java.util.Hashtable;
+import java.util.Vector;
+
+import com.sun.squawk.vm.OPC;
+import com.sun.squawk.translator.ir.instr.*;
+
+/**
+ * This pass finds the <code>int</code> array loads that can never fail and
+ * marks them so that they are emitted as <i>aload_unchecked_i</i>, which
+ * omits the null and bounds checks. This is the case for the canonical
+ * loop over an array:
+ * <p><blockquote><pre>
+ *     for (int i = 0; i < a.length; i++) {
+ *         ... a[i] ...
+ *     }
+ * </pre></blockquote><p>
+ * A forward dataflow analysis over the local variables computes two kinds of
+ * facts at each instruction:
+ * <ul>
+ * <li><code>i</code> is non-negative: it was last assigned a non-negative
+ *     constant or an array length and has since only been incremented while
+ *     known to be less than the length of some array</li>
+ * <li><code>0 &lt;= i &lt; a.length</code>: a comparison of non-negative
+ *     <code>i</code> against <code>a.length</code> succeeded and neither local
+ *     has been assigned since. As <code>a.length</code> was evaluated,
+ *     <code>a</code> is also known to be non-null.</li>
+ * </ul>
+ * An array load is unchecked if it loads <code>a[i]</code> directly from two
+ * locals for which the second fact holds. The facts at an exception handler
+ * are always empty.
+ * <p>
+ * Only <code>int</code> loads have an unchecked opcode. It takes the last
+ * free one-byte opcode. Unchecked loads of the other types, unchecked stores
+ * and a non-null <i>getfield</i> would have to be escape opcodes. Executing
+ * an escape opcode costs a second dispatch, which is about what the omitted
+ * checks save, and adding escape opcodes outside the FLOATS block would
+ * renumber the floating point ones. For the same reason the nullness of a
+ * local is only known as part of a bound and is not tracked on its own:
+ * no opcode could make use of it.
+ */
+public final class BoundsCheckEliminator extends IRPass {
+
+    /**
+     * The fact that an index is within the bounds of an array.
+     */
+    private static final class Bound {
+        final Local index;
+        final Local array;
+
+        Bound(Local index, Local array) {
+            this.index = index;
+            this.array = array;
+        }
+
+        public boolean equals(Object o) {
+            if (o instanceof Bound) {
+                Bound b = (Bound)o;
+                return b.index == index && b.array == array;
+            }
+            return false;
+        }
+
+        public int hashCode() {
+            return index.hashCode() ^ array.hashCode();
+        }
+    }
+
+    /**
+     * The facts flowing into each branch target along the branches to the target.
+     * A target that has not yet been reached along a branch has no entry.
+     */
+    private Hashtable branchFacts;
+
+    /**
+     * Specifies if {@link #branchFacts} was changed during the current iteration.
+     */
+    private boolean factsChanged;
+
+    /**
+     * {@inheritDoc}
+     */
+    public String getName() {
+        return "bounds";
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    protected boolean optimize() {
+        branchFacts = new Hashtable();
+        try {
+            do {
+                factsChanged = false;
+                analyze(false);
+            } while (factsChanged);
+            return analyze(true);
+        } finally {
+            branchFacts = null;
+        }
+    }
+
+    /**
+     * Propagates the facts through the IR once.
+     *
+     * @param mark  true if the array loads that cannot fail are to be marked
+     * @return true if an array load was marked
+     */
+    private boolean analyze(boolean mark) {
+        boolean changed = false;
+        Hashtable facts = new Hashtable();
+        for (Instruction instruction = ir.getHead(); instruction != null; instruction = instruction.getNext()) {
+            if (instruction instanceof Catch) {
+                facts = new Hashtable();
+            } else if (instruction instanceof Phi) {
+                facts = meet(facts, (Hashtable)branchFacts.get(instruction));
+            }
+
+            /*
+             * The facts are null for an instruction that can only be reached by a branch
+             * that has not been seen yet or that cannot be reached at all
+             */
+            if (facts == null) {
+                continue;
+            }
+
+            if (instruction instanceof StoreLocal) {
+                StoreLocal store = (StoreLocal)instruction;
+                Local local = store.getLocal();
+                kill(facts, local, false);
+                StackProducer value = store.getValue();
+                Integer constant = getIntConstant(value);
+                if ((constant != null && constant.intValue() >= 0) || value instanceof ArrayLength) {
+                    facts.put(local, local);
+                }
+            } else if (instruction instanceof IncDecLocal) {
+                IncDecLocal incDec = (IncDecLocal)instruction;
+                Local local = incDec.getLocal();
+
+                /*
+                 * Incrementing an index known to be less than an array length cannot overflow
+                 */
+                kill(facts, local, incDec.isIncrement() && isBounded(facts, local));
+            } else if (instruction instanceof IfCompare) {
+                IfCompare branch = (IfCompare)instruction;
+                Hashtable taken = (Hashtable)facts.clone();
+                Bound bound = getBound(branch, facts);
+                if (bound != null) {
+                    if (isTrueWhenBounded(branch)) {
+                        taken.put(bound, bound);
+                    } else {
+                        facts.put(bound, bound);
+                    }
+                }
+                flow(branch.getTarget(), taken);
+            } else if (instruction instanceof Branch) {
+                Branch branch = (Branch)instruction;
+                flow(branch.getTarget(), facts);
+                if (!(branch instanceof If)) {
+                    facts = null;
+                }
+            } else if (instruction instanceof Switch) {
+                Switch s = (Switch)instruction;
+                Target[] targets = s.getTargets();
+                for (int i = 0; i != targets.length; ++i) {
+                    flow(targets[i], facts);
+                }
+                flow(s.getDefaultTarget(), facts);
+                facts = null;
+            } else if (instruction instanceof Return || instruction instanceof Throw) {
+                facts = null;
+            } else if (mark && instruction instanceof ArrayLoad) {
+                ArrayLoad load = (ArrayLoad)instruction;
+                if (!load.isUnchecked() && isInBounds(load, facts)) {
+                    load.setUnchecked();
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    /**
+     * Records the facts flowing along a branch.
+     *
+     * @param target  the target of the branch
+     * @param facts   the facts at the branch
+     */
+    private void flow(Target target, Hashtable facts) {
+        Object instruction = target.getTargetedInstruction();
+        Hashtable old = (Hashtable)branchFacts.get(instruction);
+        Hashtable merged = meet(old, facts);
+        if (old == null || merged.size() != old.size()) {
+            branchFacts.put(instruction, merged);
+            factsChanged = true;
+        }
+    }
+
+    /**
+     * Computes the facts that hold on both of two incoming edges.
+     *
+     * @param a  the facts along one edge or null if the edge has not been reached
+     * @param b  the facts along the other edge or null if the edge has not been reached
+     * @return the intersection of <code>a</code> and <code>b</code>
+     */
+    private static Hashtable meet(Hashtable a, Hashtable b) {
+        if (a == null) {
+            return b == null ? null : (Hashtable)b.clone();
+        }
+        if (b == null) {
+            return (Hashtable)a.clone();
+        }
+        Hashtable result = new Hashtable();
+        for (Enumeration e = a.keys(); e.hasMoreElements(); ) {
+            Object fact = e.nextElement();
+            if (b.containsKey(fact)) {
+                result.put(fact, fact);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Removes the facts about a local variable that has been updated.
+     *
+     * @param facts        the current facts
+     * @param local        the updated local variable
+     * @param nonNegative  true if the local is still known to be non-negative
+     */
+    private static void kill(Hashtable facts, Local local, boolean nonNegative) {
+        Vector killed = new Vector();
+        for (Enumeration e = facts.keys(); e.hasMoreElements(); ) {
+            Object fact = e.nextElement();
+            if (fact instanceof Bound) {
+                Bound bound = (Bound)fact;
+                if (bound.index == local || bound.array == local) {
+                    killed.addElement(fact);
+                }
+            }
+        }
+        for (int i = 0; i != killed.size(); ++i) {
+            facts.remove(killed.elementAt(i));
+        }
+        if (!nonNegative) {
+            facts.remove(local);
+        }
+    }
+
+    /**
+     * Determines if a local is known to be less than the length of some array.
+     *
+     * @param facts  the current facts
+     * @param local  the local variable
+     * @return true if there is a {@link Bound} for <code>local</code>
+     */
+    private static boolean isBounded(Hashtable facts, Local local) {
+        for (Enumeration e = facts.keys(); e.hasMoreElements(); ) {
+            Object fact = e.nextElement();
+            if (fact instanceof Bound && ((Bound)fact).index == local) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Gets the bound established by a conditional branch that compares a
+     * non-negative local with the length of an array in a local.
+     *
+     * @param branch  the conditional branch
+     * @param facts   the facts at the branch
+     * @return the bound or null if <code>branch</code> is not such a comparison
+     */
+    private static Bound getBound(IfCompare branch, Hashtable facts) {
+        int opcode = branch.getOpcode();
+        if (opcode < OPC.IF_CMPEQ_I || opcode > OPC.IF_CMPGE_I) {
+            return null;
+        }
+        int condition = opcode - OPC.IF_CMPEQ_I;
+        StackProducer left = branch.getLeft();
+        StackProducer right = branch.getRight();
+        StackProducer index;
+        ArrayLength length;
+        if ((condition == LT || condition == GE) && right instanceof ArrayLength) {
+            index = left;
+            length = (ArrayLength)right;
+        } else if ((condition == GT || condition == LE) && left instanceof ArrayLength) {
+            index = right;
+            length = (ArrayLength)left;
+        } else {
+            return null;
+        }
+        StackProducer array = length.getArray();
+        if (!(index instanceof LoadLocal) || !(array instanceof LoadLocal)) {
+            return null;
+        }
+
+        /*
+         * The locals must not be updated between being loaded and the comparison
+         */
+        Instruction previous = branch.getPrevious();
+        for (int i = 0; i != 3; ++i) {
+            if (previous != index && previous != array && previous != length) {
+                return null;
+            }
+            previous = previous.getPrevious();
+        }
+
+        Local indexLocal = ((LoadLocal)index).getLocal();
+        if (!facts.containsKey(indexLocal)) {
+            return null;
+        }
+        return new Bound(indexLocal, ((LoadLocal)array).getLocal());
+    }
+
+    /**
+     * The conditions of the <code>int</code> comparison opcodes as offsets from <code>OPC.IF_CMPEQ_I</code>.
+     */
+    private static final int LT = 2, LE = 3, GT = 4, GE = 5;
+
+    /**
+     * Determines if the branch established by {@link #getBound} is taken when the index is within bounds.
+     *
+     * @param branch  the conditional branch
+     * @return true if the bound holds at the target of <code>branch</code>,
+     *         false if it holds at the next instruction
+     */
+    private static boolean isTrueWhenBounded(IfCompare branch) {
+        int condition = branch.getOpcode() - OPC.IF_CMPEQ_I;
+        return condition == LT || condition == GT;
+    }
+
+    /**
+     * Determines if an array load loads an element at an index known to be within bounds.
+     *
+     * @param load   the array load
+     * @param facts  the facts at the load
+     * @return true if <code>load</code> cannot fail
+     */
+    private static boolean isInBounds(ArrayLoad load, Hashtable facts) {
+        StackProducer array = load.getArray();
+        StackProducer index = load.getIndex();
+        if (!(array instanceof LoadLocal) || !(index instanceof LoadLocal)) {
+            return false;
+        }
+        if (load.getPrevious() != index || index.getPrevious() != array) {
+            return false;
+        }
+        return facts.containsKey(new Bound(((LoadLocal)index).getLocal(), ((LoadLocal)array).getLocal()));
+    }
+}
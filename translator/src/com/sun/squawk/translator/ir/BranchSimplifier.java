@@ -0,0 +1,174 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Hashtable;
+
+import com.sun.squawk.vm.OPC;
+import com.sun.squawk.translator.ir.instr.*;
+
+/**
+ * This pass simplifies the branches whose outcome is known at translation time:
+ * <ul>
+ * <li>a conditional branch that compares constants is replaced with an unconditional
+ *     branch if the comparison is always true and removed otherwise</li>
+ * <li>an unconditional branch to the instruction immediately following it is removed</li>
+ * </ul>
+ */
+public final class BranchSimplifier extends IRPass {
+
+    /**
+     * {@inheritDoc}
+     */
+    public String getName() {
+        return "branch";
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    protected boolean optimize() {
+        Hashtable consumers = computeConsumers();
+        boolean changed = false;
+        Instruction instruction = ir.getHead();
+        while (instruction != null) {
+            Instruction next = instruction.getNext();
+            if (instruction instanceof If) {
+                If branch = (If)instruction;
+                int outcome = evaluate(branch, consumers);
+                if (outcome != UNKNOWN) {
+                    if (branch instanceof IfCompare) {
+                        removeOperand(((IfCompare)branch).getLeft(), consumers);
+                        removeOperand(((IfCompare)branch).getRight(), consumers);
+                    } else {
+                        removeOperand(branch.getValue(), consumers);
+                    }
+                    replace(branch, outcome == TAKEN ? new Branch(branch.getTarget(), branch.isForward()) : null, consumers);
+                    changed = true;
+                }
+            } else if (instruction.getClass() == Branch.class) {
+                Branch branch = (Branch)instruction;
+                if (branch.isForward() && nextNonPseudoInstruction(branch) == branch.getTarget().getTargetedInstruction()) {
+                    replace(branch, null, consumers);
+                    changed = true;
+                }
+            }
+            instruction = next;
+        }
+        return changed;
+    }
+
+    /**
+     * The possible outcomes of evaluating a conditional branch.
+     */
+    private static final int UNKNOWN = 0, TAKEN = 1, NOT_TAKEN = 2;
+
+    /**
+     * Evaluates the comparison performed by a conditional branch.
+     *
+     * @param branch     the conditional branch
+     * @param consumers  the consumers of the producers in the IR
+     * @return UNKNOWN if the comparison cannot be evaluated or the operands cannot be
+     *         removed, otherwise TAKEN or NOT_TAKEN
+     */
+    private static int evaluate(If branch, Hashtable consumers) {
+        int opcode = branch.getOpcode();
+        StackProducer left;
+        StackProducer right;
+        if (branch instanceof IfCompare) {
+            left = ((IfCompare)branch).getLeft();
+            right = ((IfCompare)branch).getRight();
+            if (!isSingleUse(left, consumers) || !isSingleUse(right, consumers)) {
+                return UNKNOWN;
+            }
+            if (opcode >= OPC.IF_CMPEQ_I && opcode <= OPC.IF_CMPGE_I) {
+                return compare(opcode - OPC.IF_CMPEQ_I, getIntConstant(left), getIntConstant(right));
+            } else if (opcode >= OPC.IF_CMPEQ_L && opcode <= OPC.IF_CMPGE_L) {
+                return compare(opcode - OPC.IF_CMPEQ_L, getLongConstant(left), getLongConstant(right));
+            } else if (opcode == OPC.IF_CMPEQ_O || opcode == OPC.IF_CMPNE_O) {
+                return compareReferences(opcode == OPC.IF_CMPEQ_O, left, right);
+            }
+        } else {
+            left = branch.getValue();
+            if (!isSingleUse(left, consumers)) {
+                return UNKNOWN;
+            }
+            if (opcode >= OPC.IF_EQ_I && opcode <= OPC.IF_GE_I) {
+                return compare(opcode - OPC.IF_EQ_I, getIntConstant(left), new Integer(0));
+            } else if (opcode >= OPC.IF_EQ_L && opcode <= OPC.IF_GE_L) {
+                return compare(opcode - OPC.IF_EQ_L, getLongConstant(left), new Long(0));
+            } else if (opcode == OPC.IF_EQ_O || opcode == OPC.IF_NE_O) {
+                return compareReferences(opcode == OPC.IF_EQ_O, left, null);
+            }
+        }
+        return UNKNOWN;
+    }
+
+    /**
+     * Evaluates a numeric comparison.
+     *
+     * @param condition  the condition as an offset from the EQ variant of the opcode (EQ, NE, LT, LE, GT, GE)
+     * @param x          the left value or null if it is not a constant
+     * @param y          the right value or null if it is not a constant
+     * @return the outcome of the comparison
+     */
+    private static int compare(int condition, Object x, Object y) {
+        if (x == null || y == null) {
+            return UNKNOWN;
+        }
+        long l = (x instanceof Integer) ? ((Integer)x).intValue() : ((Long)x).longValue();
+        long r = (y instanceof Integer) ? ((Integer)y).intValue() : ((Long)y).longValue();
+        boolean result;
+        switch (condition) {
+            case 0:  result = l == r; break;
+            case 1:  result = l != r; break;
+            case 2:  result = l <  r; break;
+            case 3:  result = l <= r; break;
+            case 4:  result = l >  r; break;
+            case 5:  result = l >= r; break;
+            default: return UNKNOWN;
+        }
+        return result ? TAKEN : NOT_TAKEN;
+    }
+
+    /**
+     * Evaluates a reference equality comparison. Only comparisons against a
+     * <code>null</code> constant are evaluated.
+     *
+     * @param eq     true for an equality comparison, false for an inequality comparison
+     * @param left   the left operand
+     * @param right  the right operand or null if the comparison is against <code>null</code>
+     * @return the outcome of the comparison
+     */
+    private static int compareReferences(boolean eq, StackProducer left, StackProducer right) {
+        if (!(left instanceof ConstantObject) || (right != null && !(right instanceof ConstantObject))) {
+            return UNKNOWN;
+        }
+        Object x = ((Constant)left).getValue();
+        Object y = right == null ? null : ((Constant)right).getValue();
+        if (x != null && y != null) {
+            return UNKNOWN;
+        }
+        return ((x == y) == eq) ? TAKEN : NOT_TAKEN;
+    }
+
+    /**
+     * Gets the first instruction after a given instruction that is not a pseudo instruction.
+     *
+     * @param instruction  the instruction
+     * @return the first non-pseudo instruction after <code>instruction</code>
+     */
+    private static Instruction nextNonPseudoInstruction(Instruction instruction) {
+        Instruction next = instruction.getNext();
+        while (next instanceof PseudoInstruction) {
+            next = next.getNext();
+        }
+        return next;
+    }
+}
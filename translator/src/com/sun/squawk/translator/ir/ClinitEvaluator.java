@@ -0,0 +1,298 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Enumeration;
+import java.util.Hashtable;
+import java.util.Vector;
+
+import com.sun.squawk.util.Tracer;
+import com.sun.squawk.translator.ir.instr.*;
+
+/**
+ * An instance of this evaluates the <code>&lt;clinit&gt;</code> method of a class
+ * at romize time. If the method only initializes the static fields of its class
+ * with constants and arrays of constants then the resulting values are recorded
+ * in the class (see {@link Klass#setClinitTemplate}) and the class is initialized
+ * at runtime by copying these values instead of executing the method.
+ * <p>
+ * The evaluation is done on the IR of the method before it is transformed by the
+ * {@link IRTransformer}. It gives up as soon as it encounters an instruction whose
+ * effect cannot be determined without executing Squawk code. This includes all
+ * branches, invokes and object allocations as well as accesses to the fields of
+ * other classes. The only arrays that are evaluated are one dimensional arrays of
+ * primitives (other than floating point types) or strings.
+ */
+public final class ClinitEvaluator {
+
+    /**
+     * The value used in the tables of this evaluator to represent <code>null</code>.
+     */
+    private final static Object NULL = new Object();
+
+    /**
+     * The IR of the <code>&lt;clinit&gt;</code> method.
+     */
+    private final IR ir;
+
+    /**
+     * The class whose <code>&lt;clinit&gt;</code> method is being evaluated.
+     */
+    private final Klass klass;
+
+    /**
+     * The values produced by the instructions evaluated so far.
+     */
+    private final Hashtable values = new Hashtable();
+
+    /**
+     * The current values of the local variables.
+     */
+    private final Hashtable locals = new Hashtable();
+
+    /**
+     * The current values of the static fields assigned so far.
+     */
+    private final Hashtable statics = new Hashtable();
+
+    /**
+     * Creates an evaluator for the <code>&lt;clinit&gt;</code> method of a class.
+     *
+     * @param ir     the IR of the <code>&lt;clinit&gt;</code> method before it has been transformed
+     * @param klass  the class defining the method
+     */
+    public ClinitEvaluator(IR ir, Klass klass) {
+        this.ir = ir;
+        this.klass = klass;
+    }
+
+    /**
+     * Evaluates the <code>&lt;clinit&gt;</code> method and if successful, records the
+     * computed values of the static fields in the class.
+     *
+     * @return true if the method was evaluated
+     */
+    public boolean evaluate() {
+        for (Instruction instruction = ir.getHead(); instruction != null; instruction = instruction.getNext()) {
+            if (instruction instanceof Return) {
+                if (!isUnaliased()) {
+                    return false;
+                }
+                Field[] fields = new Field[statics.size()];
+                Object[] fieldValues = new Object[fields.length];
+                int i = 0;
+                for (Enumeration e = statics.keys(); e.hasMoreElements(); ++i) {
+                    fields[i] = (Field)e.nextElement();
+                    fieldValues[i] = unwrap(statics.get(fields[i]));
+                }
+                klass.setClinitTemplate(fields, fieldValues);
+                if (Klass.DEBUG && Tracer.isTracing("converting", klass.getName())) {
+                    Tracer.traceln("[evaluated <clinit> of " + klass + " at romize time]");
+                }
+                return true;
+            }
+            if (!evaluate(instruction)) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Evaluates a single instruction.
+     *
+     * @param instruction  the instruction to evaluate
+     * @return false if the effect of <code>instruction</code> cannot be determined
+     */
+    private boolean evaluate(Instruction instruction) {
+        Object value;
+        if (instruction instanceof Position || instruction instanceof Pop) {
+            return true;
+        } else if (instruction instanceof ConstantInt || instruction instanceof ConstantLong) {
+            value = ((Constant)instruction).getValue();
+        } else if (instruction instanceof ConstantObject) {
+            value = ((Constant)instruction).getValue();
+            if (value != null && !(value instanceof String)) {
+                return false;
+            }
+        } else if (instruction instanceof NewArray) {
+            NewArray newArray = (NewArray)instruction;
+            Object length = values.get(newArray.getLength());
+            if (!(length instanceof Integer) || ((Integer)length).intValue() < 0) {
+                return false;
+            }
+            value = newArray(newArray.getType().getComponentType(), ((Integer)length).intValue());
+            if (value == null) {
+                return false;
+            }
+        } else if (instruction instanceof ArrayStore) {
+            ArrayStore store = (ArrayStore)instruction;
+            return storeElement(values.get(store.getArray()), values.get(store.getIndex()), values.get(store.getValue()));
+        } else if (instruction instanceof LoadLocal) {
+            value = locals.get(((LoadLocal)instruction).getLocal());
+            if (value == null) {
+                return false;
+            }
+            values.put(instruction, value);
+            return true;
+        } else if (instruction instanceof StoreLocal) {
+            StoreLocal store = (StoreLocal)instruction;
+            value = values.get(store.getValue());
+            if (value == null) {
+                return false;
+            }
+            locals.put(store.getLocal(), value);
+            return true;
+        } else if (instruction instanceof GetStatic) {
+            Field field = ((GetStatic)instruction).getField();
+            if (!isEvaluable(field)) {
+                return false;
+            }
+            value = statics.get(field);
+            if (value == null) {
+                value = field.getType().isPrimitive() ? (Object)new Integer(0) : NULL;
+            }
+        } else if (instruction instanceof PutStatic) {
+            PutStatic store = (PutStatic)instruction;
+            Field field = store.getField();
+            value = values.get(store.getValue());
+            if (value == null || value instanceof Long || !isEvaluable(field) || field.getType().isPrimitive() != (value instanceof Integer)) {
+                return false;
+            }
+            statics.put(field, value);
+            return true;
+        } else {
+            return false;
+        }
+        values.put(instruction, value == null ? NULL : value);
+        return true;
+    }
+
+    /**
+     * Determines if a static field can be accessed by the evaluated code. The field
+     * must be declared by the class being initialized and must either be a
+     * reference or a primitive field no larger than an <code>int</code>.
+     *
+     * @param field  the field
+     * @return true if <code>field</code> can be accessed
+     */
+    private boolean isEvaluable(Field field) {
+        if (field.getDefiningClass() != klass || field.hasConstant()) {
+            return false;
+        }
+        Klass type = field.getType();
+        return !type.isPrimitive() || (type != Klass.LONG && type != Klass.FLOAT && type != Klass.DOUBLE);
+    }
+
+    /**
+     * Creates a host array for a <code>newarray</code> or <code>anewarray</code> instruction.
+     *
+     * @param componentType  the component type of the array
+     * @param length         the length of the array
+     * @return the array or null if arrays of <code>componentType</code> cannot be evaluated
+     */
+    private static Object newArray(Klass componentType, int length) {
+        if (componentType == Klass.BOOLEAN) {
+            return new boolean[length];
+        } else if (componentType == Klass.BYTE) {
+            return new byte[length];
+        } else if (componentType == Klass.CHAR) {
+            return new char[length];
+        } else if (componentType == Klass.SHORT) {
+            return new short[length];
+        } else if (componentType == Klass.INT) {
+            return new int[length];
+        } else if (componentType == Klass.LONG) {
+            return new long[length];
+        } else if (componentType == Klass.STRING) {
+            return new String[length];
+        } else {
+            return null;
+        }
+    }
+
+    /**
+     * Stores a value into an array created by the evaluated code.
+     *
+     * @param array  the array
+     * @param index  the index
+     * @param value  the value
+     * @return false if the store would raise an exception or the value is of the wrong type
+     */
+    private static boolean storeElement(Object array, Object index, Object value) {
+        if (!(index instanceof Integer) || value == null) {
+            return false;
+        }
+        int i = ((Integer)index).intValue();
+        if (array instanceof long[]) {
+            if (!(value instanceof Long) || i < 0 || i >= ((long[])array).length) {
+                return false;
+            }
+            ((long[])array)[i] = ((Long)value).longValue();
+            return true;
+        } else if (array instanceof String[]) {
+            if (!(value == NULL || value instanceof String) || i < 0 || i >= ((String[])array).length) {
+                return false;
+            }
+            ((String[])array)[i] = (String)unwrap(value);
+            return true;
+        }
+        if (!(value instanceof Integer)) {
+            return false;
+        }
+        int v = ((Integer)value).intValue();
+        if (array instanceof int[] && i >= 0 && i < ((int[])array).length) {
+            ((int[])array)[i] = v;
+        } else if (array instanceof short[] && i >= 0 && i < ((short[])array).length) {
+            ((short[])array)[i] = (short)v;
+        } else if (array instanceof char[] && i >= 0 && i < ((char[])array).length) {
+            ((char[])array)[i] = (char)v;
+        } else if (array instanceof byte[] && i >= 0 && i < ((byte[])array).length) {
+            ((byte[])array)[i] = (byte)v;
+        } else if (array instanceof boolean[] && i >= 0 && i < ((boolean[])array).length) {
+            ((boolean[])array)[i] = (v & 1) != 0;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Determines if no array is the value of more than one static field. Each field
+     * gets its own copy of its array when the class is initialized from the
+     * computed values so shared arrays would no longer be shared.
+     *
+     * @return true if there are no shared arrays
+     */
+    private boolean isUnaliased() {
+        Vector arrays = new Vector();
+        for (Enumeration e = statics.elements(); e.hasMoreElements(); ) {
+            Object value = e.nextElement();
+            if (value != NULL && !(value instanceof Integer) && !(value instanceof String)) {
+                for (int i = 0; i != arrays.size(); ++i) {
+                    if (arrays.elementAt(i) == value) {
+                        return false;
+                    }
+                }
+                arrays.addElement(value);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Converts a value from the tables of this evaluator to the value it represents.
+     *
+     * @param value  a table value
+     * @return <code>null</code> if <code>value</code> is {@link #NULL} otherwise <code>value</code>
+     */
+    private static Object unwrap(Object value) {
+        return value == NULL ? null : value;
+    }
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Hashtable;
+
+import com.sun.squawk.vm.OPC;
+import com.sun.squawk.translator.ci.Opcode;
+import com.sun.squawk.translator.ir.instr.*;
+
+/**
+ * This pass replaces the <code>int</code> and <code>long</code> arithmetic,
+ * negation and conversion operations as well as the comparison operations
+ * whose operands are all constants with the constant result of the operation.
+ * Division and remainder operations by zero are left untouched so that they
+ * still raise an <code>ArithmeticException</code> at runtime. Floating point
+ * arithmetic is never folded but floating point comparisons are, as their
+ * result does not depend on the rounding mode.
+ */
+public final class ConstantFolder extends IRPass {
+
+    /**
+     * {@inheritDoc}
+     */
+    public String getName() {
+        return "fold";
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    protected boolean optimize() {
+        Hashtable consumers = computeConsumers();
+        boolean changed = false;
+        Instruction instruction = ir.getHead();
+        while (instruction != null) {
+            Instruction next = instruction.getNext();
+            if (instruction instanceof StackProducer) {
+                StackProducer producer = (StackProducer)instruction;
+                if (!producer.isDuped() && !producer.isSpilt()) {
+                    Constant result = fold(producer, consumers);
+                    if (result != null) {
+                        replace(producer, result, consumers);
+                        changed = true;
+                    }
+                }
+            }
+            instruction = next;
+        }
+        return changed;
+    }
+
+    /**
+     * Computes the constant result of an operation and removes its operands.
+     *
+     * @param producer   the operation
+     * @param consumers  the consumers of the producers in the IR
+     * @return the constant result of <code>producer</code> or null if it cannot be folded
+     */
+    private Constant fold(StackProducer producer, Hashtable consumers) {
+        Constant result = null;
+        if (producer instanceof ArithmeticOp) {
+            ArithmeticOp op = (ArithmeticOp)producer;
+            if (isSingleUse(op.getLeft(), consumers) && isSingleUse(op.getRight(), consumers)) {
+                result = foldArithmetic(op.getOpcode(), op.getLeft(), op.getRight());
+                if (result != null) {
+                    removeOperand(op.getLeft(), consumers);
+                    removeOperand(op.getRight(), consumers);
+                }
+            }
+        } else if (producer instanceof NegationOp) {
+            NegationOp op = (NegationOp)producer;
+            if (isSingleUse(op.getValue(), consumers)) {
+                result = foldUnary(op.getOpcode(), op.getValue());
+                if (result != null) {
+                    removeOperand(op.getValue(), consumers);
+                }
+            }
+        } else if (producer instanceof ComparisonOp) {
+            ComparisonOp op = (ComparisonOp)producer;
+            if (isSingleUse(op.getLeft(), consumers) && isSingleUse(op.getRight(), consumers)) {
+                result = foldComparison(op.getJVMOpcode(), op.getLeft(), op.getRight());
+                if (result != null) {
+                    removeOperand(op.getLeft(), consumers);
+                    removeOperand(op.getRight(), consumers);
+                }
+            }
+        } else if (producer instanceof ConversionOp) {
+            ConversionOp op = (ConversionOp)producer;
+            if (isSingleUse(op.getValue(), consumers)) {
+                result = foldUnary(op.getOpcode(), op.getValue());
+                if (result != null) {
+                    removeOperand(op.getValue(), consumers);
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Folds a binary arithmetic operation.
+     *
+     * @param opcode  the Squawk opcode of the operation
+     * @param left    the left operand
+     * @param right   the right operand
+     * @return the constant result or null if the operation cannot be folded
+     */
+    private static Constant foldArithmetic(int opcode, StackProducer left, StackProducer right) {
+        Integer i1 = getIntConstant(left);
+        Integer i2 = getIntConstant(right);
+        if (i1 != null && i2 != null) {
+            int x = i1.intValue();
+            int y = i2.intValue();
+            int r;
+            switch (opcode) {
+                case OPC.ADD_I:  r = x + y;   break;
+                case OPC.SUB_I:  r = x - y;   break;
+                case OPC.MUL_I:  r = x * y;   break;
+                case OPC.AND_I:  r = x & y;   break;
+                case OPC.OR_I:   r = x | y;   break;
+                case OPC.XOR_I:  r = x ^ y;   break;
+                case OPC.SHL_I:  r = x << y;  break;
+                case OPC.SHR_I:  r = x >> y;  break;
+                case OPC.USHR_I: r = x >>> y; break;
+                case OPC.DIV_I:  if (y == 0) return null; r = x / y; break;
+                case OPC.REM_I:  if (y == 0) return null; r = x % y; break;
+                default:         return null;
+            }
+            return new ConstantInt(new Integer(r));
+        }
+
+        Long l1 = getLongConstant(left);
+        if (l1 != null) {
+            long x = l1.longValue();
+            if (i2 != null) {
+                int y = i2.intValue();
+                long r;
+                switch (opcode) {
+                    case OPC.SHL_L:  r = x << y;  break;
+                    case OPC.SHR_L:  r = x >> y;  break;
+                    case OPC.USHR_L: r = x >>> y; break;
+                    default:         return null;
+                }
+                return new ConstantLong(new Long(r));
+            }
+            Long l2 = getLongConstant(right);
+            if (l2 != null) {
+                long y = l2.longValue();
+                long r;
+                switch (opcode) {
+                    case OPC.ADD_L:  r = x + y;   break;
+                    case OPC.SUB_L:  r = x - y;   break;
+                    case OPC.MUL_L:  r = x * y;   break;
+                    case OPC.AND_L:  r = x & y;   break;
+                    case OPC.OR_L:   r = x | y;   break;
+                    case OPC.XOR_L:  r = x ^ y;   break;
+                    case OPC.DIV_L:  if (y == 0) return null; r = x / y; break;
+                    case OPC.REM_L:  if (y == 0) return null; r = x % y; break;
+                    default:         return null;
+                }
+                return new ConstantLong(new Long(r));
+            }
+        }
+        return null;
+    }
+
+    /**
+     * Folds a comparison operation.
+     *
+     * @param opcode  the JVM opcode of the operation
+     * @param left    the left operand
+     * @param right   the right operand
+     * @return the constant result or null if the operation cannot be folded
+     */
+    private static Constant foldComparison(int opcode, StackProducer left, StackProducer right) {
+        int r;
+        switch (opcode) {
+            case Opcode.opc_lcmp: {
+                Long l1 = getLongConstant(left);
+                Long l2 = getLongConstant(right);
+                if (l1 == null || l2 == null) {
+                    return null;
+                }
+                long x = l1.longValue();
+                long y = l2.longValue();
+                r = (x < y) ? -1 : ((x == y) ? 0 : 1);
+                break;
+            }
+/*if[FLOATS]*/
+            case Opcode.opc_fcmpl:
+            case Opcode.opc_fcmpg: {
+                if (!(left instanceof ConstantFloat) || !(right instanceof ConstantFloat)) {
+                    return null;
+                }
+                float x = ((Float)((Constant)left).getValue()).floatValue();
+                float y = ((Float)((Constant)right).getValue()).floatValue();
+                if (x != x || y != y) {
+                    r = (opcode == Opcode.opc_fcmpl) ? -1 : 1;
+                } else {
+                    r = (x < y) ? -1 : ((x == y) ? 0 : 1);
+                }
+                break;
+            }
+            case Opcode.opc_dcmpl:
+            case Opcode.opc_dcmpg: {
+                if (!(left instanceof ConstantDouble) || !(right instanceof ConstantDouble)) {
+                    return null;
+                }
+                double x = ((Double)((Constant)left).getValue()).doubleValue();
+                double y = ((Double)((Constant)right).getValue()).doubleValue();
+                if (x != x || y != y) {
+                    r = (opcode == Opcode.opc_dcmpl) ? -1 : 1;
+                } else {
+                    r = (x < y) ? -1 : ((x == y) ? 0 : 1);
+                }
+                break;
+            }
+/*end[FLOATS]*/
+            default:
+                return null;
+        }
+        return new ConstantInt(new Integer(r));
+    }
+
+    /**
+     * Folds a negation or conversion operation.
+     *
+     * @param opcode  the Squawk opcode of the operation
+     * @param value   the operand
+     * @return the constant result or null if the operation cannot be folded
+     */
+    private static Constant foldUnary(int opcode, StackProducer value) {
+        Integer i = getIntConstant(value);
+        if (i != null) {
+            int x = i.intValue();
+            switch (opcode) {
+                case OPC.NEG_I: return new ConstantInt(new Integer(-x));
+                case OPC.I2B:   return new ConstantInt(new Integer((byte)x));
+                case OPC.I2S:   return new ConstantInt(new Integer((short)x));
+                case OPC.I2C:   return new ConstantInt(new Integer((char)x));
+                case OPC.I2L:   return new ConstantLong(new Long(x));
+                default:        return null;
+            }
+        }
+        Long l = getLongConstant(value);
+        if (l != null) {
+            long x = l.longValue();
+            switch (opcode) {
+                case OPC.NEG_L: return new ConstantLong(new Long(-x));
+                case OPC.L2I:   return new ConstantInt(new Integer((int)x));
+                default:        return null;
+            }
+        }
+        return null;
+    }
+}
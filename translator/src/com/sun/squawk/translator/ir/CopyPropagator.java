@@ -0,0 +1,124 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Enumeration;
+import java.util.Hashtable;
+import java.util.Vector;
+
+import com.sun.squawk.translator.ir.instr.*;
+
+/**
+ * This pass propagates the values of the local variables that are assigned
+ * exactly once. The verifier guarantees that the single store to such a
+ * variable precedes every load of the variable on every path and so:
+ * <ul>
+ * <li>if the stored value is an <code>int</code> or <code>long</code> constant
+ *     then each load of the variable is replaced with the constant</li>
+ * <li>if the stored value is loaded from another variable that is itself never
+ *     modified after its own single assignment (or that is a parameter that is
+ *     never modified) then each load of the variable is replaced with a load of
+ *     the other variable</li>
+ * </ul>
+ * The store itself is left in place and is removed by the {@link DeadStoreEliminator}
+ * once the variable is no longer read.
+ */
+public final class CopyPropagator extends IRPass {
+
+    /**
+     * {@inheritDoc}
+     */
+    public String getName() {
+        return "copyprop";
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    protected boolean optimize() {
+        Hashtable consumers = computeConsumers();
+        Hashtable localUses = computeLocalUses();
+        boolean changed = false;
+        for (Enumeration e = localUses.keys(); e.hasMoreElements(); ) {
+            Local local = (Local)e.nextElement();
+            LocalUses uses = (LocalUses)localUses.get(local);
+            if (!isSingleAssignment(local, uses) || uses.loads.isEmpty()) {
+                continue;
+            }
+            StackProducer value = ((StoreLocal)uses.stores.firstElement()).getValue();
+            if (value instanceof ConstantInt || value instanceof ConstantLong) {
+                Object constant = ((Constant)value).getValue();
+                changed |= replaceLoads(uses.loads, constant, null, null, consumers);
+            } else if (value instanceof LoadLocal) {
+                LoadLocal source = (LoadLocal)value;
+                LocalUses sourceUses = (LocalUses)localUses.get(source.getLocal());
+                if (source.getLocal() != local && isUnmodified(source.getLocal(), sourceUses)) {
+                    changed |= replaceLoads(uses.loads, null, source, sourceUses, consumers);
+                }
+            }
+        }
+        return changed;
+    }
+
+    /**
+     * Determines if a local variable is assigned exactly once by a <code>StoreLocal</code>
+     * instruction and never modified by any other instruction.
+     *
+     * @param local  the local variable
+     * @param uses   the instructions accessing <code>local</code>
+     * @return true if <code>local</code> is assigned exactly once
+     */
+    private static boolean isSingleAssignment(Local local, LocalUses uses) {
+        return !local.isParameter() && !uses.isThis && uses.stores.size() == 1 && uses.incDecs.isEmpty();
+    }
+
+    /**
+     * Determines if the value of a local variable never changes once it has been initialized.
+     *
+     * @param local  the local variable
+     * @param uses   the instructions accessing <code>local</code>
+     * @return true if <code>local</code> is a parameter that is never modified or a variable assigned exactly once
+     */
+    private static boolean isUnmodified(Local local, LocalUses uses) {
+        if (uses.isThis || !uses.incDecs.isEmpty()) {
+            return false;
+        }
+        return local.isParameter() ? uses.stores.isEmpty() : uses.stores.size() == 1;
+    }
+
+    /**
+     * Replaces the loads of a local variable with either a constant or a load of another variable.
+     *
+     * @param loads        the loads to replace
+     * @param constant     the constant value of the variable or null
+     * @param source       the load whose variable is copied into the variable if <code>constant</code> is null
+     * @param sourceUses   the instructions accessing the variable of <code>source</code>
+     * @param consumers    the consumers of the producers in the IR
+     * @return true if any load was replaced
+     */
+    private boolean replaceLoads(Vector loads, Object constant, LoadLocal source, LocalUses sourceUses, Hashtable consumers) {
+        boolean changed = false;
+        for (int i = 0; i != loads.size(); ++i) {
+            LoadLocal load = (LoadLocal)loads.elementAt(i);
+            if (load.isDuped() || load.isSpilt()) {
+                continue;
+            }
+            if (constant != null) {
+                replace(load, Constant.create(constant), consumers);
+            } else {
+                LoadLocal copy = new LoadLocal(source.getType(), source.getLocal(), false);
+                replace(load, copy, consumers);
+                sourceUses.loads.addElement(copy);
+            }
+            loads.removeElementAt(i--);
+            changed = true;
+        }
+        return changed;
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Enumeration;
+import java.util.Hashtable;
+import java.util.Vector;
+
+import com.sun.squawk.translator.ir.instr.*;
+
+/**
+ * This pass removes the stores to the local variables that are never read.
+ * The stored value is removed as well if it is a constant or a load of a
+ * local variable. Otherwise it is popped as it may have been produced by an
+ * instruction with side effects.
+ */
+public final class DeadStoreEliminator extends IRPass {
+
+    /**
+     * {@inheritDoc}
+     */
+    public String getName() {
+        return "dse";
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    protected boolean optimize() {
+        Hashtable consumers = computeConsumers();
+        Hashtable localUses = computeLocalUses();
+        boolean changed = false;
+        for (Enumeration e = localUses.keys(); e.hasMoreElements(); ) {
+            Local local = (Local)e.nextElement();
+            LocalUses uses = (LocalUses)localUses.get(local);
+            if (local.isParameter() || uses.isThis || !uses.loads.isEmpty()) {
+                continue;
+            }
+            for (int i = 0; i != uses.incDecs.size(); ++i) {
+                replace((Instruction)uses.incDecs.elementAt(i), null, consumers);
+                changed = true;
+            }
+            for (int i = 0; i != uses.stores.size(); ++i) {
+                StoreLocal store = (StoreLocal)uses.stores.elementAt(i);
+                StackProducer value = store.getValue();
+                if ((value instanceof Constant || value instanceof LoadLocal) && isSingleUse(value, consumers)) {
+                    replace(store, null, consumers);
+                    removeOperand(value, consumers);
+                } else {
+                    Pop pop = new Pop(value);
+                    replace(store, pop, consumers);
+                    Vector list = (Vector)consumers.get(value);
+                    list.setElementAt(pop, list.indexOf(store));
+                }
+                changed = true;
+            }
+        }
+        return changed;
+    }
+}
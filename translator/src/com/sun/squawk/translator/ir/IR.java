@@ -398,6 +398,13 @@ public final class IR {
         }
 /*end[J2ME.DEBUG]*/
 
+        /*
+         * Record the references made by the body for the romizer's tree shaker.
+         */
+        if (emitter.getObjectIndexes() != null) {
+            MethodReferences.record(body, this, emitter.getObjectIndexes());
+        }
+
         return body;
     }
 
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Hashtable;
+import java.util.Vector;
+
+import com.sun.squawk.util.Assert;
+import com.sun.squawk.translator.ir.instr.*;
+
+/**
+ * This is the base class for the optimizations that may be applied by the
+ * {@link IRPassManager} to the IR of a method before it is transformed by the
+ * {@link IRTransformer}. At that point the IR still closely follows the JVM
+ * bytecode: every stack producer is an instruction that pushes a value to the
+ * operand stack and the value is popped by the instruction(s) that reference
+ * the producer as an operand.
+ * <p>
+ * A pass must never remove a producer whose value is still consumed and so
+ * the utility methods in this class only remove producers that are consumed
+ * by exactly one instruction and whose value has neither been duped nor spilt.
+ */
+public abstract class IRPass {
+
+    /**
+     * The IR being optimized.
+     */
+    protected IR ir;
+
+    /**
+     * The method encapsulating the IR.
+     */
+    protected Method method;
+
+    /**
+     * Gets the name by which this pass is enabled.
+     *
+     * @return the name of this pass
+     */
+    public abstract String getName();
+
+    /**
+     * Notifies this pass that the IR of a method has been built. This is called for
+     * every method before any pass is applied to the method.
+     *
+     * @param ir      the IR of the method
+     * @param method  the method encapsulating the IR
+     */
+    public void methodBuilt(IR ir, Method method) {
+    }
+
+    /**
+     * Applies this pass to the IR of a method.
+     *
+     * @param ir      the IR to optimize
+     * @param method  the method encapsulating the IR
+     * @return true if the IR was changed
+     */
+    public final boolean run(IR ir, Method method) {
+        this.ir = ir;
+        this.method = method;
+        try {
+            return optimize();
+        } finally {
+            this.ir = null;
+            this.method = null;
+        }
+    }
+
+    /**
+     * Applies this pass to {@link #ir}.
+     *
+     * @return true if the IR was changed
+     */
+    protected abstract boolean optimize();
+
+    /*---------------------------------------------------------------------------*\
+     *                                 Utilities                                 *
+    \*---------------------------------------------------------------------------*/
+
+    /**
+     * Computes the consumers of every stack producer in the IR.
+     *
+     * @return a table mapping each stack producer with at least one consumer to
+     *         a <code>Vector</code> of the instructions that consume it
+     */
+    protected final Hashtable computeConsumers() {
+        final Hashtable consumers = new Hashtable();
+        OperandVisitor visitor = new OperandVisitor() {
+            public StackProducer doOperand(Instruction instruction, StackProducer operand) {
+                Vector list = (Vector)consumers.get(operand);
+                if (list == null) {
+                    list = new Vector();
+                    consumers.put(operand, list);
+                }
+                list.addElement(instruction);
+                return operand;
+            }
+        };
+        for (Instruction instruction = ir.getHead(); instruction != null; instruction = instruction.getNext()) {
+            instruction.visit(visitor);
+        }
+        return consumers;
+    }
+
+    /**
+     * Determines if a given stack producer can be removed together with the only
+     * instruction that consumes it.
+     *
+     * @param producer   the producer
+     * @param consumers  the table computed by {@link #computeConsumers}
+     * @return true if <code>producer</code> is consumed by exactly one instruction
+     *         and its value has not been duped or spilt
+     */
+    protected static boolean isSingleUse(StackProducer producer, Hashtable consumers) {
+        Vector list = (Vector)consumers.get(producer);
+        return list != null && list.size() == 1 && !producer.isDuped() && !producer.isSpilt();
+    }
+
+    /**
+     * Replaces an instruction with another one. If the instruction being replaced
+     * is a stack producer then all the references to it are updated to refer to
+     * the replacement.
+     *
+     * @param old          the instruction being replaced
+     * @param replacement  the replacement instruction or null if <code>old</code> is simply removed
+     * @param consumers    the table computed by {@link #computeConsumers} which is updated accordingly
+     */
+    protected final void replace(Instruction old, Instruction replacement, Hashtable consumers) {
+        if (replacement != null) {
+            replacement.setBytecodeOffset(old.getBytecodeOffset());
+            ir.insertBefore(replacement, old);
+        }
+        ir.remove(old);
+        if (old instanceof StackProducer) {
+            Vector list = (Vector)consumers.remove(old);
+            if (list != null) {
+                Assert.that(replacement instanceof StackProducer);
+                final StackProducer from = (StackProducer)old;
+                final StackProducer to = (StackProducer)replacement;
+                OperandVisitor visitor = new OperandVisitor() {
+                    public StackProducer doOperand(Instruction instruction, StackProducer operand) {
+                        return operand == from ? to : operand;
+                    }
+                };
+                for (int i = 0; i != list.size(); ++i) {
+                    ((Instruction)list.elementAt(i)).visit(visitor);
+                }
+                consumers.put(to, list);
+            }
+        }
+    }
+
+    /**
+     * Removes the instruction that is the only consumer of a stack producer together with the producer.
+     *
+     * @param producer   the producer
+     * @param consumers  the table computed by {@link #computeConsumers} which is updated accordingly
+     */
+    protected final void removeOperand(StackProducer producer, Hashtable consumers) {
+        Assert.that(isSingleUse(producer, consumers));
+        consumers.remove(producer);
+        ir.remove(producer);
+    }
+
+    /**
+     * The instructions that access a single local variable.
+     */
+    protected static final class LocalUses {
+
+        /**
+         * The <code>LoadLocal</code> instructions reading the variable.
+         */
+        public final Vector loads = new Vector();
+
+        /**
+         * The <code>StoreLocal</code> instructions writing the variable.
+         */
+        public final Vector stores = new Vector();
+
+        /**
+         * The <code>IncDecLocal</code> instructions updating the variable.
+         */
+        public final Vector incDecs = new Vector();
+
+        /**
+         * Specifies if the variable is accessed by an instruction dealing
+         * with the copy of <code>this</code> in a constructor.
+         */
+        public boolean isThis;
+    }
+
+    /**
+     * Computes the instructions that access each local variable in the IR.
+     *
+     * @return a table mapping each accessed <code>Local</code> to its {@link LocalUses}
+     */
+    protected final Hashtable computeLocalUses() {
+        Hashtable uses = new Hashtable();
+        for (Instruction instruction = ir.getHead(); instruction != null; instruction = instruction.getNext()) {
+            if (instruction instanceof LocalVariable) {
+                Local local = ((LocalVariable)instruction).getLocal();
+                LocalUses localUses = (LocalUses)uses.get(local);
+                if (localUses == null) {
+                    localUses = new LocalUses();
+                    uses.put(local, localUses);
+                }
+                if (instruction instanceof LoadLocal) {
+                    localUses.loads.addElement(instruction);
+                    localUses.isThis |= ((LoadLocal)instruction).isThis();
+                } else if (instruction instanceof StoreLocal) {
+                    localUses.stores.addElement(instruction);
+                    localUses.isThis |= ((StoreLocal)instruction).isThis();
+                } else {
+                    localUses.incDecs.addElement(instruction);
+                }
+            }
+        }
+        return uses;
+    }
+
+    /**
+     * Gets the int value of a producer if it is an <code>int</code> constant.
+     *
+     * @param producer  the producer
+     * @return the value of <code>producer</code> or null if it is not an int constant
+     */
+    protected static Integer getIntConstant(StackProducer producer) {
+        if (producer instanceof ConstantInt) {
+            return (Integer)((Constant)producer).getValue();
+        }
+        return null;
+    }
+
+    /**
+     * Gets the long value of a producer if it is a <code>long</code> constant.
+     *
+     * @param producer  the producer
+     * @return the value of <code>producer</code> or null if it is not a long constant
+     */
+    protected static Long getLongConstant(StackProducer producer) {
+        if (producer instanceof ConstantLong) {
+            return (Long)((Constant)producer).getValue();
+        }
+        return null;
+    }
+}
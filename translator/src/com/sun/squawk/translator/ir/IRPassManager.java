@@ -0,0 +1,152 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import com.sun.squawk.util.Tracer;
+
+/**
+ * The <code>IRPassManager</code> applies the enabled {@link IRPass optimization passes}
+ * to the IR of each method before it is transformed by the {@link IRTransformer}.
+ * The passes are applied in a fixed order and the whole sequence is repeated
+ * while it still changes the IR, up to {@link #MAX_ROUNDS} times.
+ * <p>
+ * A translator creates a new pass manager for each suite it translates so that
+ * both the set of enabled passes and the state the passes gather about the
+ * methods of a suite are specific to that suite.
+ */
+public final class IRPassManager {
+
+    /**
+     * The maximum number of times the sequence of enabled passes is applied to a method.
+     */
+    private static final int MAX_ROUNDS = 4;
+
+    /**
+     * The passes that are enabled.
+     */
+    private final IRPass[] enabled;
+
+    /**
+     * Creates a pass manager with a given set of enabled passes.
+     *
+     * @param names  a comma separated list of pass names, "all" to enable all passes
+     *               or "" to disable all passes
+     * @throws IllegalArgumentException if <code>names</code> contains an unknown pass name
+     */
+    public IRPassManager(String names) {
+        IRPass[] passes = createPasses();
+        if (names.equals("all")) {
+            enabled = passes;
+            return;
+        }
+        boolean[] selected = new boolean[passes.length];
+        int count = 0;
+        int start = 0;
+        while (start < names.length()) {
+            int end = names.indexOf(',', start);
+            if (end == -1) {
+                end = names.length();
+            }
+            String name = names.substring(start, end);
+            int i = 0;
+            while (i != passes.length && !passes[i].getName().equals(name)) {
+                ++i;
+            }
+            if (i == passes.length) {
+                throw new IllegalArgumentException("unknown optimization pass: " + name);
+            }
+            if (!selected[i]) {
+                selected[i] = true;
+                ++count;
+            }
+            start = end + 1;
+        }
+        enabled = new IRPass[count];
+        count = 0;
+        for (int i = 0; i != passes.length; ++i) {
+            if (selected[i]) {
+                enabled[count++] = passes[i];
+            }
+        }
+    }
+
+    /**
+     * Creates an instance of each of the available passes in the order in which they are applied.
+     *
+     * @return the passes
+     */
+    private static IRPass[] createPasses() {
+        return new IRPass[] {
+            new Inliner(),
+            new ScalarReplacer(),
+            new ConstantFolder(),
+            new BranchSimplifier(),
+            new CopyPropagator(),
+            new DeadStoreEliminator(),
+            new UnreachableCodeEliminator(),
+            new BoundsCheckEliminator()
+        };
+    }
+
+    /**
+     * Gets the names of all the available passes.
+     *
+     * @return the names of the available passes separated by commas
+     */
+    public static String getPassNames() {
+        IRPass[] passes = createPasses();
+        StringBuffer buf = new StringBuffer();
+        for (int i = 0; i != passes.length; ++i) {
+            if (i != 0) {
+                buf.append(',');
+            }
+            buf.append(passes[i].getName());
+        }
+        return buf.toString();
+    }
+
+    /**
+     * Notifies the enabled passes that the IR of a method has been built.
+     *
+     * @param ir      the IR of the method
+     * @param method  the method
+     */
+    public void methodBuilt(IR ir, Method method) {
+        for (int i = 0; i != enabled.length; ++i) {
+            enabled[i].methodBuilt(ir, method);
+        }
+    }
+
+    /**
+     * Applies the enabled passes to the IR of a method.
+     *
+     * @param ir      the IR of the method before it has been transformed
+     * @param method  the method
+     */
+    public void optimize(IR ir, Method method) {
+        for (int round = 0; round != MAX_ROUNDS; ++round) {
+            boolean changed = false;
+            for (int i = 0; i != enabled.length; ++i) {
+                IRPass pass = enabled[i];
+                if (pass.run(ir, method)) {
+                    changed = true;
+/*if[J2ME.DEBUG]*/
+                    if (Klass.DEBUG && Tracer.isTracing("optimizer", method.toString())) {
+                        Tracer.traceln("[" + pass.getName() + " changed " + method + "]");
+                        new InstructionTracer(ir).traceAll();
+                    }
+/*end[J2ME.DEBUG]*/
+                }
+            }
+            if (!changed) {
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,265 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Hashtable;
+import java.util.Vector;
+
+import com.sun.squawk.util.Tracer;
+import com.sun.squawk.translator.ir.instr.*;
+
+/**
+ * This pass replaces the invocations of trivial methods with the body of the
+ * invoked method. A method is trivial if its IR matches one of these templates:
+ * <ul>
+ * <li>an accessor: <code>return this.f;</code></li>
+ * <li>a mutator: <code>this.f = p;</code></li>
+ * <li>a static method returning an <code>int</code> or <code>long</code> constant</li>
+ * <li>a static method with an empty body</li>
+ * </ul>
+ * The template of a method is recorded when the IR for the method is built
+ * and so only methods in the suite being translated that have been built before
+ * the caller is optimized are inlined. This includes all the methods of the
+ * caller's class and of its super classes.
+ * <p>
+ * An invocation is only inlined if the invoked method cannot be overridden
+ * (i.e. it is invoked via <i>invokestatic</i> or <i>invokespecial</i>
+ * or it is private, final or declared by a final class). Constructors,
+ * synchronized methods and methods whose invocation may trigger class
+ * initialization are never inlined. An inlined accessor or mutator still
+ * raises a <code>NullPointerException</code> for a <code>null</code> receiver
+ * and the instruction replacing the invocation keeps its bytecode offset
+ * so that exception handler ranges and line numbers are preserved.
+ */
+public final class Inliner extends IRPass {
+
+    /**
+     * The kinds of templates.
+     */
+    private static final int GETTER = 1, SETTER = 2, CONSTANT = 3, EMPTY = 4;
+
+    /**
+     * The template of a trivial method.
+     */
+    private static final class Template {
+        final int kind;
+        final Field field;
+        final Object constant;
+
+        Template(int kind, Field field, Object constant) {
+            this.kind = kind;
+            this.field = field;
+            this.constant = constant;
+        }
+    }
+
+    /**
+     * The templates of the trivial methods of the suite built so far.
+     */
+    private final Hashtable templates = new Hashtable();
+
+    /**
+     * {@inheritDoc}
+     */
+    public String getName() {
+        return "inline";
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    public void methodBuilt(IR ir, Method method) {
+        Template template = match(ir, method);
+        if (template != null) {
+            templates.put(method, template);
+        }
+    }
+
+    /**
+     * Matches the IR of a method against the templates of trivial methods.
+     *
+     * @param ir      the IR of the method before it has been transformed
+     * @param method  the method
+     * @return the template matched by <code>ir</code> or null
+     */
+    private static Template match(IR ir, Method method) {
+        if (method.isConstructor() || method.isClassInitializer() || method.isSynchronized() || method.getDefiningClass().isSquawkNative()) {
+            return null;
+        }
+        Instruction[] body = new Instruction[4];
+        int length = 0;
+        for (Instruction instruction = ir.getHead(); instruction != null; instruction = instruction.getNext()) {
+            if (instruction instanceof Position) {
+                continue;
+            }
+            if (length == body.length) {
+                return null;
+            }
+            body[length++] = instruction;
+        }
+        if (length == 0 || !(body[length - 1] instanceof Return)) {
+            return null;
+        }
+        StackProducer value = ((Return)body[length - 1]).getValue();
+        if (method.isStatic()) {
+            if (length == 1) {
+                return new Template(EMPTY, null, null);
+            }
+            if (length == 2 && (value instanceof ConstantInt || value instanceof ConstantLong) && body[0] == value) {
+                return new Template(CONSTANT, null, ((Constant)value).getValue());
+            }
+        } else {
+            if (length == 3 && body[1] instanceof GetField && value == body[1]) {
+                GetField get = (GetField)body[1];
+                if (isParameterLoad(body[0], 0) && get.getObject() == body[0]) {
+                    return new Template(GETTER, get.getField(), null);
+                }
+            }
+            if (length == 4 && body[2] instanceof PutField && value == null) {
+                PutField put = (PutField)body[2];
+                if (isParameterLoad(body[0], 0) && isParameterLoad(body[1], 1) && put.getObject() == body[0] && put.getValue() == body[1]) {
+                    return new Template(SETTER, put.getField(), null);
+                }
+            }
+        }
+        return null;
+    }
+
+    /**
+     * Determines if an instruction loads a given parameter of the enclosing method.
+     *
+     * @param instruction  the instruction
+     * @param javacIndex   the javac local variable index of the parameter
+     * @return true if <code>instruction</code> loads the parameter
+     */
+    private static boolean isParameterLoad(Instruction instruction, int javacIndex) {
+        if (instruction instanceof LoadLocal) {
+            Local local = ((LoadLocal)instruction).getLocal();
+            return local.isParameter() && local.getJavacIndex() == javacIndex;
+        }
+        return false;
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    protected boolean optimize() {
+        Hashtable consumers = null;
+        boolean changed = false;
+        Instruction instruction = ir.getHead();
+        while (instruction != null) {
+            Instruction next = instruction.getNext();
+            if (instruction instanceof Invoke) {
+                Invoke invoke = (Invoke)instruction;
+                Template template = getTemplate(invoke);
+                if (template != null && !invoke.isDuped() && !invoke.isSpilt()) {
+                    if (consumers == null) {
+                        consumers = computeConsumers();
+                    }
+                    if (inline(invoke, template, consumers)) {
+                        changed = true;
+                    }
+                }
+            }
+            instruction = next;
+        }
+        return changed;
+    }
+
+    /**
+     * Gets the template for the method invoked by an invocation if the invocation can be inlined.
+     *
+     * @param invoke  the invocation
+     * @return the template of the invoked method or null if the invocation cannot be inlined
+     */
+    private Template getTemplate(Invoke invoke) {
+        Method callee = invoke.getMethod();
+        Template template = (Template)templates.get(callee);
+        if (template == null || callee == method) {
+            return null;
+        }
+        if (invoke instanceof InvokeVirtual) {
+            if (!callee.isPrivate() && !callee.isFinal() && !callee.getDefiningClass().isFinal()) {
+                return null;
+            }
+        } else if (invoke instanceof InvokeStatic) {
+            if (callee.requiresClassClinit() && callee.getDefiningClass() != method.getDefiningClass()) {
+                return null;
+            }
+        } else if (!(invoke instanceof InvokeSuper)) {
+            return null;
+        }
+        return template;
+    }
+
+    /**
+     * Replaces an invocation with the body of the invoked method.
+     *
+     * @param invoke     the invocation
+     * @param template   the template of the invoked method
+     * @param consumers  the consumers of the producers in the IR
+     * @return true if the invocation was replaced
+     */
+    private boolean inline(Invoke invoke, Template template, Hashtable consumers) {
+        StackProducer[] parameters = invoke.getParameters();
+        boolean isVoid = template.kind == SETTER || template.kind == EMPTY;
+        if (isVoid && consumers.get(invoke) != null) {
+            return false;
+        }
+        switch (template.kind) {
+            case GETTER: {
+                GetField get = new GetField(template.field, parameters[0]);
+                replaceConsumer(parameters[0], invoke, get, consumers);
+                replace(invoke, get, consumers);
+                break;
+            }
+            case SETTER: {
+                PutField put = new PutField(template.field, parameters[0], parameters[1]);
+                replaceConsumer(parameters[0], invoke, put, consumers);
+                replaceConsumer(parameters[1], invoke, put, consumers);
+                replace(invoke, put, consumers);
+                break;
+            }
+            case CONSTANT:
+            case EMPTY: {
+                for (int i = 0; i != parameters.length; ++i) {
+                    Pop pop = new Pop(parameters[i]);
+                    pop.setBytecodeOffset(invoke.getBytecodeOffset());
+                    ir.insertBefore(pop, invoke);
+                    replaceConsumer(parameters[i], invoke, pop, consumers);
+                }
+                replace(invoke, template.kind == CONSTANT ? Constant.create(template.constant) : null, consumers);
+                break;
+            }
+            default: {
+                return false;
+            }
+        }
+
+/*if[J2ME.DEBUG]*/
+        if (Klass.DEBUG && Tracer.isTracing("optimizer", method.toString())) {
+            Tracer.traceln("[inlined " + invoke.getMethod() + " in " + method + "]");
+        }
+/*end[J2ME.DEBUG]*/
+        return true;
+    }
+
+    /**
+     * Records that a producer is consumed by a new instruction in place of an invocation.
+     *
+     * @param producer     the producer
+     * @param invoke       the invocation being replaced
+     * @param replacement  the instruction replacing <code>invoke</code>
+     * @param consumers    the consumers of the producers in the IR
+     */
+    private static void replaceConsumer(StackProducer producer, Invoke invoke, Instruction replacement, Hashtable consumers) {
+        Vector list = (Vector)consumers.get(producer);
+        list.setElementAt(replacement, list.indexOf(invoke));
+    }
+}
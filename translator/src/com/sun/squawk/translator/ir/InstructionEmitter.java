@@ -137,6 +137,12 @@ public class InstructionEmitter implements InstructionVisitor {
      */
     private final Method method;
 
+    /**
+     * The indexes (as <code>Integer</code>s) of the object table entries used by
+     * the emitted code or null if they are not being {@link MethodReferences recorded}.
+     */
+    private final Hashtable objectIndexes;
+
     /**
      * The emitter execution states.
      */
@@ -174,6 +180,7 @@ public class InstructionEmitter implements InstructionVisitor {
         this.classFile    = classFile;
         this.method       = method;
         this.clearedSlots = clearedSlots;
+        this.objectIndexes = MethodReferences.isEnabled() ? new Hashtable() : null;
 /*if[J2ME.DEBUG]*/
         this.trace        = Klass.DEBUG && Tracer.isTracing("emitter", method.toString());
 /*end[J2ME.DEBUG]*/
@@ -251,6 +258,14 @@ public class InstructionEmitter implements InstructionVisitor {
 /*end[J2ME.STATS]*/
         }
 
+        /*
+         * Emit a preemption point at the entry of an application method so that a
+         * thread executing call intensive code without loops can be preempted.
+         */
+        if (isAppClass) {
+            emitOpcode(OPC.BBTARGET_APP);
+        }
+
 
         /*
          * Iterate over the IR.
@@ -418,6 +433,15 @@ public class InstructionEmitter implements InstructionVisitor {
         return code;
     }
 
+    /**
+     * Gets the indexes of the object table entries used by the emitted code.
+     *
+     * @return the indexes (as <code>Integer</code>s) or null if they were not recorded
+     */
+    Hashtable getObjectIndexes() {
+        return objectIndexes;
+    }
+
 /*if[TYPEMAP]*/
     /**
      * Gets the type map describing the type of the value (if any) written to memory by each instruction.
@@ -818,6 +842,10 @@ public class InstructionEmitter implements InstructionVisitor {
         } else {
             try {
                 int index = classFile.getConstantObjectIndex(object);
+                if (objectIndexes != null) {
+                    Integer key = new Integer(index);
+                    objectIndexes.put(key, key);
+                }
                 emitCompact(OPC.OBJECT, OPC.OBJECT_0, OPC.OBJECT_0_COUNT, index);
             } catch (java.util.NoSuchElementException ex) {
                 throw new LinkageError("no copy of object in class's object table: " + object);
@@ -973,7 +1001,9 @@ public class InstructionEmitter implements InstructionVisitor {
             case CID.BYTE:    opcode = OPC.ALOAD_B; break;
             case CID.CHAR:    opcode = OPC.ALOAD_C; break;
             case CID.SHORT:   opcode = OPC.ALOAD_S; break;
-            case CID.INT:     opcode = OPC.ALOAD_I; break;
+            case CID.INT:     opcode = instruction.isUnchecked() ?
+                                       OPC.ALOAD_UNCHECKED_I :
+                                       OPC.ALOAD_I; break;
             case CID.LONG:    opcode = OPC.ALOAD_L; break;
 /*if[FLOATS]*/
             case CID.FLOAT:   opcode = OPC.ALOAD_F; break;
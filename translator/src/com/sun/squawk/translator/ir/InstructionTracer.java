@@ -219,7 +219,7 @@ public class InstructionTracer implements InstructionVisitor {
             case CID.BYTE:   opcode = OPC.ALOAD_B; break;
             case CID.CHAR:   opcode = OPC.ALOAD_C; break;
             case CID.SHORT:  opcode = OPC.ALOAD_S; break;
-            case CID.INT:    opcode = OPC.ALOAD_I; break;
+            case CID.INT:    opcode = instruction.isUnchecked() ? OPC.ALOAD_UNCHECKED_I : OPC.ALOAD_I; break;
             case CID.LONG:   opcode = OPC.ALOAD_L; break;
 /*if[FLOATS]*/
             case CID.FLOAT:  opcode = OPC.ALOAD_F; break;
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Enumeration;
+
+import com.sun.squawk.translator.ir.instr.*;
+import com.sun.squawk.util.Vector;    // Version without synchronization
+import com.sun.squawk.util.Hashtable; // Version without synchronization
+
+/**
+ * A <code>MethodReferences</code> instance records the methods invoked, the
+ * classes referenced and the entries of the class's object table used by the
+ * Squawk bytecode of a method body. The references are only recorded once
+ * {@link #enable recording} has been enabled and they are used by the romizer
+ * to compute the methods reachable from a set of entry points.
+ */
+public final class MethodReferences {
+
+    /**
+     * The kind of an invocation whose target is the method in the static
+     * method table of the method's defining class.
+     */
+    public static final int STATIC = 0;
+
+    /**
+     * The kind of an invocation whose target is the method in the vtable
+     * of the method's defining class (i.e. <i>invokesuper</i>).
+     */
+    public static final int SUPER = 1;
+
+    /**
+     * The kind of an invocation whose target is the method in the vtable
+     * of the receiver's class.
+     */
+    public static final int VIRTUAL = 2;
+
+    /**
+     * The kind of an invocation of an interface method.
+     */
+    public static final int INTERFACE = 3;
+
+    /**
+     * Specifies if references are recorded.
+     */
+    private static boolean enabled;
+
+    /**
+     * The references of each method body translated while recording was enabled.
+     */
+    private static Hashtable references = new Hashtable();
+
+    /**
+     * The invoked methods.
+     */
+    private final Method[] methods;
+
+    /**
+     * The kind of each invocation in {@link #methods}.
+     */
+    private final int[] kinds;
+
+    /**
+     * The referenced classes.
+     */
+    private final Klass[] classes;
+
+    /**
+     * The indexes of the used entries in the object table of the defining class.
+     */
+    private final int[] objectIndexes;
+
+    /**
+     * Creates the record of the references made by a method body.
+     */
+    private MethodReferences(Method[] methods, int[] kinds, Klass[] classes, int[] objectIndexes) {
+        this.methods = methods;
+        this.kinds = kinds;
+        this.classes = classes;
+        this.objectIndexes = objectIndexes;
+    }
+
+    /**
+     * Enables the recording of references for all the methods translated from now on.
+     */
+    public static void enable() {
+        enabled = true;
+    }
+
+    /**
+     * Determines if references are being recorded.
+     *
+     * @return true if references are being recorded
+     */
+    public static boolean isEnabled() {
+        return enabled;
+    }
+
+    /**
+     * Records the references made by a method body.
+     *
+     * @param body           the method body
+     * @param ir             the transformed IR from which <code>body</code> was emitted
+     * @param objectIndexes  the indexes (as <code>Integer</code>s) of the object table entries used by <code>body</code>
+     */
+    static void record(MethodBody body, IR ir, Hashtable objectIndexes) {
+        Vector invoked = new Vector();
+        Vector kinds = new Vector();
+        Hashtable classes = new Hashtable();
+        for (Instruction instruction = ir.getHead(); instruction != null; instruction = instruction.getNext()) {
+            if (instruction instanceof Invoke) {
+                Method method = ((Invoke)instruction).getMethod();
+                int kind;
+                if (instruction instanceof InvokeStatic) {
+                    kind = STATIC;
+                } else if (instruction instanceof InvokeSuper) {
+                    kind = SUPER;
+                } else if (instruction instanceof InvokeSlot) {
+                    kind = INTERFACE;
+                } else {
+                    kind = VIRTUAL;
+                }
+                invoked.addElement(method);
+                kinds.addElement(new Integer(kind));
+                classes.put(method.getDefiningClass(), method.getDefiningClass());
+            }
+            Object object = instruction.getConstantObject();
+            if (object instanceof Klass) {
+                classes.put(object, object);
+            }
+        }
+
+        Method[] methodArray = new Method[invoked.size()];
+        int[] kindArray = new int[methodArray.length];
+        for (int i = 0; i != methodArray.length; ++i) {
+            methodArray[i] = (Method)invoked.elementAt(i);
+            kindArray[i] = ((Integer)kinds.elementAt(i)).intValue();
+        }
+
+        Klass[] classArray = new Klass[classes.size()];
+        int i = 0;
+        for (Enumeration e = classes.keys(); e.hasMoreElements(); ) {
+            classArray[i++] = (Klass)e.nextElement();
+        }
+
+        int[] indexArray = new int[objectIndexes.size()];
+        i = 0;
+        for (Enumeration e = objectIndexes.keys(); e.hasMoreElements(); ) {
+            indexArray[i++] = ((Integer)e.nextElement()).intValue();
+        }
+
+        references.put(body, new MethodReferences(methodArray, kindArray, classArray, indexArray));
+    }
+
+    /**
+     * Gets the references recorded for a method body.
+     *
+     * @param body  the method body
+     * @return the references made by <code>body</code> or null if none were recorded
+     */
+    public static MethodReferences get(MethodBody body) {
+        return (MethodReferences)references.get(body);
+    }
+
+    /**
+     * Gets the number of invocations made by the method body.
+     *
+     * @return the number of invocations
+     */
+    public int getInvocationCount() {
+        return methods.length;
+    }
+
+    /**
+     * Gets the method invoked by an invocation.
+     *
+     * @param index  the index of the invocation
+     * @return the invoked method
+     */
+    public Method getInvokedMethod(int index) {
+        return methods[index];
+    }
+
+    /**
+     * Gets the kind of an invocation.
+     *
+     * @param index  the index of the invocation
+     * @return {@link #STATIC}, {@link #SUPER}, {@link #VIRTUAL} or {@link #INTERFACE}
+     */
+    public int getInvocationKind(int index) {
+        return kinds[index];
+    }
+
+    /**
+     * Gets the classes referenced by the method body. This includes the classes
+     * instantiated and the defining classes of the invoked methods.
+     *
+     * @return the referenced classes
+     */
+    public Klass[] getReferencedClasses() {
+        return classes;
+    }
+
+    /**
+     * Gets the indexes of the entries in the object table of the defining class
+     * that are used by the method body.
+     *
+     * @return the object table indexes
+     */
+    public int[] getObjectIndexes() {
+        return objectIndexes;
+    }
+}
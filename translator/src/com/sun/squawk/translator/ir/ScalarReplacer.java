@@ -0,0 +1,478 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Hashtable;
+import java.util.Vector;
+
+import com.sun.squawk.util.Tracer;
+import com.sun.squawk.vm.CID;
+import com.sun.squawk.translator.ir.instr.*;
+
+/**
+ * This pass removes the allocation of objects that do not escape the method
+ * allocating them and replaces the fields of such an object with local
+ * variables. An object does not escape if:
+ * <ul>
+ * <li>it is initialized by a constructor that only assigns parameters or
+ *     constants to fields of its class (and whose class is a direct subclass
+ *     of <code>java.lang.Object</code>)</li>
+ * <li>it is stored in a local variable that is not assigned anywhere else
+ *     in the method</li>
+ * <li>every load of that local variable is used directly as the receiver of a
+ *     <i>getfield</i>, <i>putfield</i>, <i>monitorenter</i> or <i>monitorexit</i></li>
+ * </ul>
+ * The accesses to the fields become accesses to the local variables and
+ * the monitor operations are removed. As the {@link Inliner} runs first,
+ * the objects whose fields are only accessed via trivial accessors and
+ * mutators are also replaced.
+ * <p>
+ * The constructor of the class of an object must have been built before the
+ * method allocating the object is optimized. The allocation of an object whose
+ * class requires initialization is only removed from the methods of the class
+ * itself so that removing it never skips the class initializer.
+ */
+public final class ScalarReplacer extends IRPass {
+
+    /**
+     * The template of a constructor that only assigns values to fields.
+     */
+    private static final class Template {
+
+        /**
+         * The assigned fields.
+         */
+        final Field[] fields;
+
+        /**
+         * The positions of the parameters assigned to <code>fields</code>
+         * in the parameters of the constructor (the receiver being at 0) or -1
+         * if the field is assigned a constant.
+         */
+        final int[] parameters;
+
+        /**
+         * The constants assigned to <code>fields</code> which are only
+         * meaningful if the field is not assigned a parameter.
+         */
+        final Object[] constants;
+
+        Template(Field[] fields, int[] parameters, Object[] constants) {
+            this.fields = fields;
+            this.parameters = parameters;
+            this.constants = constants;
+        }
+
+        /**
+         * Gets the index of a field in {@link #fields}.
+         *
+         * @param field  the field
+         * @return the index of <code>field</code> or -1 if it is not assigned
+         */
+        int indexOf(Field field) {
+            for (int i = 0; i != fields.length; ++i) {
+                if (fields[i] == field) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+    }
+
+    /**
+     * The templates of the constructors of the suite built so far.
+     */
+    private final Hashtable templates = new Hashtable();
+
+    /**
+     * {@inheritDoc}
+     */
+    public String getName() {
+        return "escape";
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    public void methodBuilt(IR ir, Method method) {
+        if (method.isConstructor()) {
+            Template template = match(ir, method);
+            if (template != null) {
+                templates.put(method, template);
+            }
+        }
+    }
+
+    /**
+     * Matches the IR of a constructor against the template of a constructor
+     * that only assigns parameters and constants to the fields of its class.
+     *
+     * @param ir      the IR of the constructor before it has been transformed
+     * @param method  the constructor
+     * @return the template matched by <code>ir</code> or null
+     */
+    private static Template match(IR ir, Method method) {
+        Klass klass = method.getDefiningClass();
+        if (klass.getSuperclass() != Klass.OBJECT || klass.isSquawkNative() || klass.hasFinalizer()) {
+            return null;
+        }
+        Vector body = new Vector();
+        for (Instruction instruction = ir.getHead(); instruction != null; instruction = instruction.getNext()) {
+            if (!(instruction instanceof Position)) {
+                body.addElement(instruction);
+            }
+        }
+
+        /*
+         * Skip the invocation of the constructor of java.lang.Object
+         */
+        int i = 0;
+        if (body.size() >= 3 && body.elementAt(1) instanceof InvokeStatic) {
+            InvokeStatic invoke = (InvokeStatic)body.elementAt(1);
+            if (invoke.getMethod().getDefiningClass() != Klass.OBJECT || !isParameterLoad(body.elementAt(0), 0) ||
+                !(body.elementAt(2) instanceof Pop) || ((Pop)body.elementAt(2)).getValue() != invoke) {
+                return null;
+            }
+            i = 3;
+        }
+
+        Klass[] parameterTypes = method.getParameterTypes();
+        Vector fields = new Vector();
+        int[] parameters = new int[body.size() / 3];
+        Object[] constants = new Object[body.size() / 3];
+        boolean[] parameterUsed = new boolean[parameterTypes.length + 1];
+        while (i + 3 <= body.size() && body.elementAt(i + 2) instanceof PutField) {
+            PutField put = (PutField)body.elementAt(i + 2);
+            Field field = put.getField();
+            if (put.getObject() != body.elementAt(i) || put.getValue() != body.elementAt(i + 1) || !isParameterLoad(put.getObject(), 0) ||
+                field.getDefiningClass() != klass || !isReplaceable(field) || fields.contains(field)) {
+                return null;
+            }
+            StackProducer value = put.getValue();
+            int index = fields.size();
+            if (value instanceof LoadLocal) {
+                int parameter = getParameterPosition(((LoadLocal)value).getLocal(), parameterTypes);
+                if (parameter <= 0 || parameterUsed[parameter]) {
+                    return null;
+                }
+                parameterUsed[parameter] = true;
+                parameters[index] = parameter;
+            } else if (value instanceof ConstantInt || value instanceof ConstantLong ||
+                       (value instanceof ConstantObject && ((Constant)value).getValue() == null)) {
+                parameters[index] = -1;
+                constants[index] = ((Constant)value).getValue();
+            } else {
+                return null;
+            }
+            fields.addElement(field);
+            i += 3;
+        }
+
+        /*
+         * The constructor must end by returning the receiver
+         */
+        if (i + 2 != body.size() || !isParameterLoad(body.elementAt(i), 0) ||
+            !(body.elementAt(i + 1) instanceof Return) || ((Return)body.elementAt(i + 1)).getValue() != body.elementAt(i)) {
+            return null;
+        }
+
+        Field[] fieldArray = new Field[fields.size()];
+        fields.copyInto(fieldArray);
+        int[] parameterArray = new int[fieldArray.length];
+        System.arraycopy(parameters, 0, parameterArray, 0, fieldArray.length);
+        Object[] constantArray = new Object[fieldArray.length];
+        System.arraycopy(constants, 0, constantArray, 0, fieldArray.length);
+        return new Template(fieldArray, parameterArray, constantArray);
+    }
+
+    /**
+     * Determines if an object is a load of a given parameter of the enclosing method.
+     *
+     * @param object      the object to test
+     * @param javacIndex  the javac local variable index of the parameter
+     * @return true if <code>object</code> loads the parameter
+     */
+    private static boolean isParameterLoad(Object object, int javacIndex) {
+        if (object instanceof LoadLocal) {
+            Local local = ((LoadLocal)object).getLocal();
+            return local.isParameter() && local.getJavacIndex() == javacIndex;
+        }
+        return false;
+    }
+
+    /**
+     * Gets the position of a parameter in the parameters of an invocation of a constructor.
+     *
+     * @param local           the local variable
+     * @param parameterTypes  the declared parameter types of the constructor
+     * @return the position of the parameter held in <code>local</code> or -1 if
+     *         <code>local</code> is not a parameter
+     */
+    private static int getParameterPosition(Local local, Klass[] parameterTypes) {
+        if (local.isParameter()) {
+            int javacIndex = 1;
+            for (int i = 0; i != parameterTypes.length; ++i) {
+                if (javacIndex == local.getJavacIndex()) {
+                    return i + 1;
+                }
+                javacIndex += (parameterTypes[i].isDoubleWord() ? 2 : 1);
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Determines if a field can be replaced by a local variable.
+     *
+     * @param field  the field
+     * @return true if <code>field</code> is an instance field holding an
+     *         integral value or a reference
+     */
+    private static boolean isReplaceable(Field field) {
+        if (field.isStatic()) {
+            return false;
+        }
+        Klass type = field.getType();
+        switch (type.getClassID()) {
+            case CID.BOOLEAN:
+            case CID.BYTE:
+            case CID.SHORT:
+            case CID.CHAR:
+            case CID.INT:
+            case CID.LONG: {
+                return true;
+            }
+            default: {
+                return !type.isPrimitive() && !type.isSquawkPrimitive();
+            }
+        }
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    protected boolean optimize() {
+        if (method.isConstructor()) {
+            return false;
+        }
+        boolean changed = false;
+        boolean replaced;
+        do {
+            replaced = false;
+            Hashtable consumers = computeConsumers();
+            Hashtable localUses = computeLocalUses();
+            for (Instruction instruction = ir.getHead(); instruction != null; instruction = instruction.getNext()) {
+                if (instruction instanceof New && replaceIfNotEscaping((New)instruction, consumers, localUses)) {
+                    replaced = changed = true;
+                    break;
+                }
+            }
+        } while (replaced);
+        return changed;
+    }
+
+    /**
+     * Replaces an object with local variables if it does not escape.
+     *
+     * @param allocation  the instruction allocating the object
+     * @param consumers   the consumers of the producers in the IR
+     * @param localUses   the uses of the local variables in the IR
+     * @return true if the object was replaced
+     */
+    private boolean replaceIfNotEscaping(New allocation, Hashtable consumers, Hashtable localUses) {
+        Klass klass = allocation.getRuntimeType();
+        if (klass == Klass.STRING || klass.hasFinalizer() || (klass.mustClinit() && klass != method.getDefiningClass()) || !isSingleUse(allocation, consumers)) {
+            return false;
+        }
+
+        /*
+         * The object must be initialized by a constructor with a template
+         */
+        Instruction consumer = (Instruction)((Vector)consumers.get(allocation)).firstElement();
+        if (!(consumer instanceof InvokeStatic)) {
+            return false;
+        }
+        InvokeStatic init = (InvokeStatic)consumer;
+        Template template = (Template)templates.get(init.getMethod());
+        if (template == null || init.getMethod().getDefiningClass() != klass || init.getParameters()[0] != allocation || !isSingleUse(init, consumers)) {
+            return false;
+        }
+
+        /*
+         * The initialized object must be immediately stored to a local variable
+         * that is not assigned anywhere else
+         */
+        if (!(init.getNext() instanceof StoreLocal) || ((StoreLocal)init.getNext()).getValue() != init) {
+            return false;
+        }
+        StoreLocal store = (StoreLocal)init.getNext();
+        Local local = store.getLocal();
+        LocalUses uses = (LocalUses)localUses.get(local);
+        if (local.isParameter() || uses.isThis || uses.stores.size() != 1 || !uses.incDecs.isEmpty()) {
+            return false;
+        }
+
+        /*
+         * Every load of the local variable must be the receiver of a field access or monitor operation
+         */
+        Vector fields = new Vector();
+        for (int i = 0; i != template.fields.length; ++i) {
+            fields.addElement(template.fields[i]);
+        }
+        for (int i = 0; i != uses.loads.size(); ++i) {
+            LoadLocal load = (LoadLocal)uses.loads.elementAt(i);
+            if (!isSingleUse(load, consumers)) {
+                return false;
+            }
+            Instruction use = (Instruction)((Vector)consumers.get(load)).firstElement();
+            if (use instanceof InstanceFieldAccessor) {
+                Field field = ((InstanceFieldAccessor)use).getField();
+                if (((InstanceFieldAccessor)use).getObject() != load || field.getDefiningClass() != klass || !isReplaceable(field)) {
+                    return false;
+                }
+                if (!fields.contains(field)) {
+                    fields.addElement(field);
+                }
+            } else if (!(use instanceof MonitorEnter || use instanceof MonitorExit)) {
+                return false;
+            }
+        }
+
+        replaceFields(allocation, init, store, template, fields, uses.loads, consumers);
+
+/*if[J2ME.DEBUG]*/
+        if (Klass.DEBUG && Tracer.isTracing("optimizer", method.toString())) {
+            Tracer.traceln("[replaced instance of " + klass + " with " + fields.size() + " locals in " + method + "]");
+        }
+/*end[J2ME.DEBUG]*/
+        return true;
+    }
+
+    /**
+     * Replaces an object that does not escape with local variables.
+     *
+     * @param allocation  the instruction allocating the object
+     * @param init        the invocation of the constructor
+     * @param store       the store of the initialized object to a local variable
+     * @param template    the template of the constructor
+     * @param fields      the fields of the object that are accessed
+     * @param loads       the loads of the local variable holding the object
+     * @param consumers   the consumers of the producers in the IR
+     */
+    private void replaceFields(New allocation, InvokeStatic init, StoreLocal store, Template template, Vector fields, Vector loads, Hashtable consumers) {
+        int nextIndex = getMaxJavacIndex() + 1;
+        Local[] locals = new Local[fields.size()];
+        for (int i = 0; i != locals.length; ++i) {
+            Klass type = Frame.getLocalTypeFor(((Field)fields.elementAt(i)).getType());
+            locals[i] = new Local(type, nextIndex, false);
+            nextIndex += type.isDoubleWord() ? 2 : 1;
+        }
+
+        /*
+         * The constructor arguments are on the operand stack in order and so they
+         * are stored (or popped) in reverse order. The fields not assigned a
+         * parameter are initialized afterwards.
+         */
+        StackProducer[] parameters = init.getParameters();
+        for (int p = parameters.length - 1; p > 0; --p) {
+            int index = -1;
+            for (int i = 0; i != template.parameters.length; ++i) {
+                if (template.parameters[i] == p) {
+                    index = i;
+                }
+            }
+            if (index == -1) {
+                insertBefore(new Pop(parameters[p]), init);
+            } else {
+                insertBefore(new StoreLocal(locals[index], parameters[p], false), init);
+            }
+        }
+        for (int i = 0; i != locals.length; ++i) {
+            Field field = (Field)fields.elementAt(i);
+            int index = template.indexOf(field);
+            if (index == -1 || template.parameters[index] == -1) {
+                Constant value = Constant.create(index == -1 ? getDefaultValue(field.getType()) : template.constants[index]);
+                insertBefore(value, init);
+                insertBefore(new StoreLocal(locals[i], value, false), init);
+            }
+        }
+        ir.remove(allocation);
+        ir.remove(init);
+        ir.remove(store);
+
+        /*
+         * Replace the accesses to the object
+         */
+        for (int i = 0; i != loads.size(); ++i) {
+            LoadLocal load = (LoadLocal)loads.elementAt(i);
+            Instruction use = (Instruction)((Vector)consumers.get(load)).firstElement();
+            if (use instanceof GetField) {
+                Field field = ((GetField)use).getField();
+                Local local = locals[fields.indexOf(field)];
+                Klass type = local.getType() == Klass.REFERENCE ? field.getType() : local.getType();
+                replace(use, new LoadLocal(type, local, false), consumers);
+            } else if (use instanceof PutField) {
+                PutField put = (PutField)use;
+                Local local = locals[fields.indexOf(put.getField())];
+                replace(put, new StoreLocal(local, put.getValue(), false), consumers);
+            } else {
+                ir.remove(use);
+            }
+            ir.remove(load);
+        }
+    }
+
+    /**
+     * Inserts a new instruction before another one, giving it the bytecode offset of the latter.
+     *
+     * @param instruction  the instruction to insert
+     * @param before       the instruction before which <code>instruction</code> is inserted
+     */
+    private void insertBefore(Instruction instruction, Instruction before) {
+        instruction.setBytecodeOffset(before.getBytecodeOffset());
+        ir.insertBefore(instruction, before);
+    }
+
+    /**
+     * Gets the highest javac local variable index used in the IR.
+     *
+     * @return the highest index of a local variable (or -1 if there is none)
+     */
+    private int getMaxJavacIndex() {
+        int max = -1;
+        for (Instruction instruction = ir.getHead(); instruction != null; instruction = instruction.getNext()) {
+            if (instruction instanceof LocalVariable) {
+                Local local = ((LocalVariable)instruction).getLocal();
+                int index = local.getJavacIndex() + (local.getType().isDoubleWord() ? 1 : 0);
+                if (index > max) {
+                    max = index;
+                }
+            }
+        }
+        return max;
+    }
+
+    /**
+     * Gets the default value of a field of a given type.
+     *
+     * @param type  the type of the field
+     * @return the value of a field of type <code>type</code> in a newly allocated object
+     */
+    private static Object getDefaultValue(Klass type) {
+        switch (type.getClassID()) {
+            case CID.LONG: return new Long(0);
+            case CID.BOOLEAN:
+            case CID.BYTE:
+            case CID.SHORT:
+            case CID.CHAR:
+            case CID.INT:  return new Integer(0);
+            default:       return null;
+        }
+    }
+}
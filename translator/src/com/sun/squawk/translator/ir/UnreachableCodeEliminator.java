@@ -0,0 +1,127 @@
+/*
+ * Copyright 2004 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ * This is a part of the Squawk JVM translator.
+ */
+package com.sun.squawk.translator.ir;
+
+import java.util.Hashtable;
+import java.util.Vector;
+
+import com.sun.squawk.translator.ir.instr.*;
+
+/**
+ * This pass removes the instructions that follow an unconditional transfer of
+ * control (a <i>goto</i>, a switch, a return or a throw) up to the next branch
+ * or exception handler target. Such instructions can never be executed. They
+ * are typically left behind by the {@link BranchSimplifier}. The pseudo
+ * instructions in a removed region are kept as they delimit the ranges of
+ * exception handlers and source positions.
+ * <p>
+ * A region is left untouched if any value it produces is consumed outside the
+ * region or if it consumes any value produced outside the region.
+ */
+public final class UnreachableCodeEliminator extends IRPass {
+
+    /**
+     * {@inheritDoc}
+     */
+    public String getName() {
+        return "unreachable";
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    protected boolean optimize() {
+        Hashtable consumers = null;
+        boolean changed = false;
+        Instruction instruction = ir.getHead();
+        while (instruction != null) {
+            if (isUnconditionalTransfer(instruction)) {
+                Vector region = new Vector();
+                Instruction next = instruction.getNext();
+                while (next != null && !(next instanceof TargetedInstruction)) {
+                    if (!(next instanceof PseudoInstruction)) {
+                        region.addElement(next);
+                    }
+                    next = next.getNext();
+                }
+                if (!region.isEmpty()) {
+                    if (consumers == null) {
+                        consumers = computeConsumers();
+                    }
+                    if (isRemovable(region, consumers)) {
+                        for (int i = 0; i != region.size(); ++i) {
+                            ir.remove((Instruction)region.elementAt(i));
+                        }
+                        changed = true;
+                    }
+                }
+                instruction = next;
+            } else {
+                instruction = instruction.getNext();
+            }
+        }
+        return changed;
+    }
+
+    /**
+     * Determines if an instruction never transfers control to the instruction following it.
+     *
+     * @param instruction  the instruction to test
+     * @return true if <code>instruction</code> is an unconditional transfer of control
+     */
+    private static boolean isUnconditionalTransfer(Instruction instruction) {
+        return (instruction instanceof Branch && !(instruction instanceof If)) ||
+               instruction instanceof Switch ||
+               instruction instanceof Return ||
+               instruction instanceof Throw;
+    }
+
+    /**
+     * Determines if a region of unreachable instructions is self contained.
+     *
+     * @param region     the non-pseudo instructions in the region
+     * @param consumers  the consumers of the producers in the IR
+     * @return true if no value flows into or out of <code>region</code>
+     */
+    private static boolean isRemovable(final Vector region, Hashtable consumers) {
+        final boolean[] result = { true };
+        OperandVisitor visitor = new OperandVisitor() {
+            public StackProducer doOperand(Instruction instruction, StackProducer operand) {
+                if (!region.contains(operand)) {
+                    result[0] = false;
+                }
+                return operand;
+            }
+        };
+        for (int i = 0; i != region.size(); ++i) {
+            Instruction instruction = (Instruction)region.elementAt(i);
+            if (instruction instanceof StackProducer) {
+                StackProducer producer = (StackProducer)instruction;
+                Vector list = (Vector)consumers.get(producer);
+
+                /*
+                 * A producer without consumers may still be referenced by a stack merge
+                 */
+                if (list == null || producer.isDuped() || producer.isSpilt()) {
+                    return false;
+                }
+                for (int j = 0; j != list.size(); ++j) {
+                    if (!region.contains(list.elementAt(j))) {
+                        return false;
+                    }
+                }
+            }
+            instruction.visit(visitor);
+            if (!result[0]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -540,8 +540,8 @@ class Verifier extends VerifierBase {
                                                   do_lookup(BYTE);                   break;
             case OPC.LOOKUP_S:                    iparmNone();
                                                   do_lookup(SHORT);                  break;
-            case OPC.RES_0:                       iparmNone();
-                                                  do_res(0);                         break;
+            case OPC.ALOAD_UNCHECKED_I:           iparmNone();
+                                                  do_aload_unchecked(INT);           break;
 /*if[FLOATS]*/
             case OPC.IF_EQ_F:                     iparmByte();
             case OPC.IF_EQ_F_WIDE:                do_if(1, EQ, FLOAT);               break;
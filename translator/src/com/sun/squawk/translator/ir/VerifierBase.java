@@ -973,7 +973,8 @@ abstract class VerifierBase {
         push(INT);
     }
 
-    protected void do_res(int n) {
+    protected void do_aload_unchecked(Klass t) {
+        do_aload(t);
     }
 
     protected void do_i2b() {
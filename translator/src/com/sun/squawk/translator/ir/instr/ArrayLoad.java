@@ -29,6 +29,11 @@ public final class ArrayLoad extends StackProducer {
      */
     private StackProducer index;
 
+    /**
+     * Specifies if the array is known to be non-null and the index is known to be within bounds.
+     */
+    private boolean unchecked;
+
     /**
      * Creates an <code>ArrayLoad</code> instance for an instruction that loads
      * a value from an array and pushes it to the operand stack.
@@ -61,6 +66,23 @@ public final class ArrayLoad extends StackProducer {
         return index;
     }
 
+    /**
+     * Records that the array is non-null and the index is within the bounds
+     * of the array whenever this instruction is executed.
+     */
+    public void setUnchecked() {
+        unchecked = true;
+    }
+
+    /**
+     * Determines if the null and bounds checks can be omitted for this instruction.
+     *
+     * @return true if the array is non-null and the index is within bounds
+     */
+    public boolean isUnchecked() {
+        return unchecked;
+    }
+
     /**
      * {@inheritDoc}
      */
@@ -42,6 +42,19 @@ public class Branch extends Instruction {
         isForward = target.getTargetedInstruction() == null;
     }
 
+    /**
+     * Creates a <code>Branch</code> instance that replaces another branch to the
+     * same address once the IR has been built. The direction of the branch cannot
+     * be derived from the target at this point and so it must be given.
+     *
+     * @param target     the address to which the flow of control is transferred
+     * @param isForward  true if the branch is forward
+     */
+    public Branch(Target target, boolean isForward) {
+        this.target = target;
+        this.isForward = isForward;
+    }
+
     /**
      * Gets the address to which the flow of control is transferred.
      *
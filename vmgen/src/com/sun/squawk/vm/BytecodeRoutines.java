@@ -110,7 +110,7 @@ abstract public class BytecodeRoutines implements Types {
     abstract protected void do_aload(Type t);
     abstract protected void do_astore(Type t);
     abstract protected void do_lookup(Type t);
-    abstract protected void do_res(int n);
+    abstract protected void do_aload_unchecked(Type t);
     abstract protected void do_const_float();
     abstract protected void do_const_double();
     abstract protected void do_i2f();
@@ -1466,19 +1466,6 @@ abstract public class Common extends BytecodeRoutines implements Types {
         callVMExtension(method, INT);
     }
 
-    /**
-     * Reserved.
-     *
-     * <p>
-     * Compiler Stack: ... -> ...
-     * <p>
-     *
-     * @param n ignored parameter
-     */
-    protected void do_res(int n) {
-        shouldNotReachHere();
-    }
-
 
     /*-----------------------------------------------------------------------*\
      *                            Native Functions                           *
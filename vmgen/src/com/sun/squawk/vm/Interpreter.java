@@ -1628,6 +1628,23 @@ public class Interpreter extends InterpreterNative {
         c.push();                       // Value
     }
 
+    /**
+     * aload_unchecked.
+     *
+     * <p>
+     * Java Stack: ..., OOP, INT -> ..., VALUE
+     * <p>
+     *
+     * @param t the operation data type
+     */
+    protected void do_aload_unchecked(Type t) {
+        c.pop(INT);                     // Index
+        c.pop(OOP);                     // Ref
+        c.swap();
+        read(t, NOCHECK);
+        c.push();                       // Value
+    }
+
     /**
      * astore.
      *
@@ -2290,19 +2307,6 @@ public class Interpreter extends InterpreterNative {
         c.push();
     }
 
-    /**
-     * Reserved.
-     *
-     * <p>
-     * Compiler Stack: ... -> ...
-     * <p>
-     *
-     * @param n ignored parameter
-     */
-    protected void do_res(int n) {
-        shouldNotReachHere();
-    }
-
 
     public static void printMmap(MethodMap mmap, String name) {
         System.out.println("Method Map" + name);
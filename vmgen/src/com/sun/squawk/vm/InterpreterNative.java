@@ -825,6 +825,39 @@ abstract class InterpreterNative extends InterpreterSwitch {
             nativepush(INT); // boolean
             nativedone();
 
+        nativebind(Native.com_sun_squawk_util_Arrays$binarySearchPrimitive);
+            nativepop(LONG); // long
+            nativepop(INT); // int
+            nativepop(INT); // int
+            nativepop(OOP); // java.lang.Object
+            invokenativeswapping(Native.com_sun_squawk_util_Arrays$binarySearchPrimitive);
+            nativepush(INT); // int
+            nativedone();
+
+        nativebind(Native.com_sun_squawk_util_Arrays$equalsPrimitive);
+            nativepop(INT); // int
+            nativepop(OOP); // java.lang.Object
+            nativepop(OOP); // java.lang.Object
+            invokenativeswapping(Native.com_sun_squawk_util_Arrays$equalsPrimitive);
+            nativepush(INT); // boolean
+            nativedone();
+
+        nativebind(Native.com_sun_squawk_util_Arrays$fillPrimitive);
+            nativepop(LONG); // long
+            nativepop(INT); // int
+            nativepop(INT); // int
+            nativepop(OOP); // java.lang.Object
+            invokenativeswapping(Native.com_sun_squawk_util_Arrays$fillPrimitive);
+            nativedone();
+
+        nativebind(Native.com_sun_squawk_util_Arrays$sortPrimitive);
+            nativepop(INT); // int
+            nativepop(INT); // int
+            nativepop(OOP); // java.lang.Object
+            invokenativeswapping(Native.com_sun_squawk_util_Arrays$sortPrimitive);
+            nativepush(INT); // boolean
+            nativedone();
+
         nativebind(Native.java_lang_VM$lcmp);
             nativepop(LONG); // long
             nativepop(LONG); // long
@@ -544,8 +544,8 @@ abstract public class InterpreterSwitch extends Common implements Types {
                                                   pre(FLOW_CALL);       do_lookup(BYTE);                   post();
             bind(OPC.LOOKUP_S);                                         iparmNone();
                                                   pre(FLOW_CALL);       do_lookup(SHORT);                  post();
-            bind(OPC.RES_0);                                            iparmNone();
-                                                  pre(FLOW_CHANGE);     do_res(0);                         post();
+            bind(OPC.ALOAD_UNCHECKED_I);                                iparmNone();
+                                                  pre(FLOW_NEXT);       do_aload_unchecked(INT);           post();
 /*if[FLOATS]*/
             bind(OPC.IF_EQ_F);                                          iparmByte();
             bind(OPC.IF_EQ_F_WIDE);               pre(FLOW_CHANGE);     do_if(1, EQ, FLOAT);               post();
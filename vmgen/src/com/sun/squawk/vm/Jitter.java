@@ -992,6 +992,17 @@ public class Jitter extends JitterSwitch {
         read(t, BOUNDSCHECK);
     }
 
+    /**
+     * aload_unchecked.
+     *
+     * <p>
+     * Compiler Stack: ..., OOP, INT -> ..., VALUE
+     * <p>
+     */
+    protected void do_aload_unchecked(Type t) {
+        read(t, NOCHECK);
+    }
+
     /**
      * astore.
      *